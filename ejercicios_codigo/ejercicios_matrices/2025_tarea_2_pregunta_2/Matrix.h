@@ -11,8 +11,11 @@
 #include <type_traits> // Para std::is_floating_point_v
 #include <stdexcept>   // Para excepciones estándar como std::out_of_range, std::invalid_argument
 #include <utility>     // Para std::swap
+#include <algorithm>   // Para std::swap_ranges, std::copy
 
 #include "Vector.h"
+#include "MatrixView.h"
+#include "gemm.h"
 
 inline int gauss_swap_count = 0;
 
@@ -26,13 +29,20 @@ template <class U> Matrix<U> inverse(const Matrix<U>& x);
 
 
 /* --- Matrix Class Declaration --- */
+// Los elementos se guardan en un único bloque contiguo, fila por fila (row-major):
+// el elemento (r, c) está en data[r * ld_ + c]. Así una matriz grande ocupa una sola
+// reserva de memoria y los recorridos por filas aprovechan la caché.
 template <class T>
 class Matrix
 {
 private:
-    std::vector<std::vector<T>> data; // Almacenamiento interno de los elementos de la matriz.
-    std::size_t rows_ = 0;             // Número de filas.
-    std::size_t cols_ = 0;             // Número de columnas.
+    std::vector<T> data;      // Almacenamiento contiguo de los elementos (por filas).
+    std::size_t rows_ = 0;    // Número de filas.
+    std::size_t cols_ = 0;    // Número de columnas.
+    std::size_t ld_ = 0;      // Dimensión principal (leading dimension): distancia entre filas.
+
+    T* row_ptr(std::size_t r) { return data.data() + r * ld_; }
+    const T* row_ptr(std::size_t r) const { return data.data() + r * ld_; }
 
     // --- Métodos auxiliares privados para operaciones de fila (modificaciones in-place) ---
     // Estos métodos modifican la matriz directamente.
@@ -40,15 +50,18 @@ private:
         if (r1 >= rows_ || r2 >= rows_) {
             throw std::out_of_range("Error: Índice de fila fuera de rango en swap_rows_internal.");
         }
-        std::swap(data[r1], data[r2]);
+        if (r1 != r2) {
+            std::swap_ranges(row_ptr(r1), row_ptr(r1) + cols_, row_ptr(r2));
+        }
     }
 
     void multiply_row_by_scalar_internal(std::size_t r, T scalar) {
         if (r >= rows_) {
             throw std::out_of_range("Error: Índice de fila fuera de rango en multiply_row_by_scalar_internal.");
         }
+        T* row = row_ptr(r);
         for (std::size_t j = 0; j < cols_; ++j) {
-            data[r][j] *= scalar;
+            row[j] *= scalar;
         }
     }
 
@@ -57,8 +70,10 @@ private:
         if (row_to_modify_idx >= rows_ || row_to_subtract_multiplied_idx >= rows_) {
             throw std::out_of_range("Error: Índice de fila fuera de rango en subtract_multiple_of_row_internal.");
         }
+        T* dst = row_ptr(row_to_modify_idx);
+        const T* src = row_ptr(row_to_subtract_multiplied_idx);
         for (std::size_t j = 0; j < cols_; ++j) {
-            data[row_to_modify_idx][j] -= factor * data[row_to_subtract_multiplied_idx][j];
+            dst[j] -= factor * src[j];
         }
     }
 
@@ -69,20 +84,20 @@ private:
         }
 
         std::size_t pivot_row = start_row;
-        T pivot_val = data[start_row][col_idx];
+        T pivot_val = data[start_row * ld_ + col_idx];
 
         if constexpr (std::is_floating_point_v<T>) {
             for (std::size_t i = start_row + 1; i < rows_; ++i) {
-                if (std::abs(data[i][col_idx]) > std::abs(pivot_val)) {
-                    pivot_val = data[i][col_idx];
+                if (std::abs(data[i * ld_ + col_idx]) > std::abs(pivot_val)) {
+                    pivot_val = data[i * ld_ + col_idx];
                     pivot_row = i;
                 }
             }
         } else {
             // Para tipos no flotantes, encuentra el primer pivote no nulo.
             for (std::size_t i = start_row + 1; i < rows_; ++i) {
-                if (data[i][col_idx] != T()) {
-                    pivot_val = data[i][col_idx];
+                if (data[i * ld_ + col_idx] != T()) {
+                    pivot_val = data[i * ld_ + col_idx];
                     pivot_row = i;
                     break;
                 }
@@ -99,42 +114,56 @@ public:
     template <class U> friend Matrix<U> inverse(const Matrix<U>& x);
 
     // --- Constructores y Destructor ---
-    Matrix() : rows_(0), cols_(0) {} // Constructor por defecto.
-    ~Matrix() = default;             // Destructor por defecto (std::vector gestiona la memoria).
+    Matrix() : rows_(0), cols_(0), ld_(0) {} // Constructor por defecto.
+    ~Matrix() = default;                     // Destructor por defecto (std::vector gestiona la memoria).
 
     // Crea una matriz vacía de dimensiones especificadas.
-    Matrix(std::size_t rows, std::size_t cols) : rows_(rows), cols_(cols) {
-        data.resize(rows);
-        for (std::size_t i = 0; i < rows; ++i) {
-            data[i].resize(cols, T()); // Inicializa con el valor por defecto de T (ej. 0 para tipos numéricos).
-        }
-    }
+    // Inicializa con el valor por defecto de T (ej. 0 para tipos numéricos).
+    Matrix(std::size_t rows, std::size_t cols) : data(rows * cols, T()), rows_(rows), cols_(cols), ld_(cols) {}
 
     // Constructor de copia.
-    Matrix(const Matrix<T>& other) : data(other.data), rows_(other.rows_), cols_(other.cols_) {}
+    Matrix(const Matrix<T>& other) : data(other.data), rows_(other.rows_), cols_(other.cols_), ld_(other.ld_) {}
+
+    // Constructor por movimiento.
+    Matrix(Matrix<T>&& other) noexcept
+        : data(std::move(other.data)), rows_(other.rows_), cols_(other.cols_), ld_(other.ld_) {
+        other.rows_ = 0; // Deja la fuente en un estado válido y vacío.
+        other.cols_ = 0;
+        other.ld_ = 0;
+    }
 
     // Inicializa la matriz con un vector de vectores.
     // (std::initializer_list sería otra opción para inicialización con {}).
-    Matrix(std::vector<std::vector<T>> elements) : data(std::move(elements)) {
-        rows_ = data.size();
-        cols_ = 0;
-        if (rows_ > 0) {
+    Matrix(std::vector<std::vector<T>> elements) {
+        rows_ = elements.size();
+        cols_ = (rows_ > 0) ? elements[0].size() : 0;
+        ld_ = cols_;
+        data.reserve(rows_ * cols_);
+        for (std::size_t i = 0; i < rows_; ++i) {
             // Asegura que todas las filas tengan el mismo número de columnas.
-            cols_ = data[0].size();
-            for (std::size_t i = 1; i < rows_; ++i) {
-                if (data[i].size() != cols_) {
-                    throw std::invalid_argument("Error: Todas las filas en el vector de inicialización deben tener el mismo número de columnas.");
-                }
+            if (elements[i].size() != cols_) {
+                throw std::invalid_argument("Error: Todas las filas en el vector de inicialización deben tener el mismo número de columnas.");
+            }
+            for (std::size_t j = 0; j < cols_; ++j) {
+                data.push_back(std::move(elements[i][j]));
+            }
+        }
+    }
+
+    // Crea una matriz (propietaria) copiando los elementos de una vista.
+    explicit Matrix(const MatrixView<const T>& view)
+        : data(view.size()), rows_(view.rows()), cols_(view.cols()), ld_(view.cols()) {
+        for (std::size_t i = 0; i < rows_; ++i) {
+            for (std::size_t j = 0; j < cols_; ++j) {
+                data[i * ld_ + j] = view(i, j);
             }
         }
     }
 
     // Crea una matriz identidad cuadrada de tamaño n x n.
-    explicit Matrix(std::size_t n) : rows_(n), cols_(n) {
-        data.resize(n);
+    explicit Matrix(std::size_t n) : data(n * n, T()), rows_(n), cols_(n), ld_(n) {
         for (std::size_t i = 0; i < n; ++i) {
-            data[i].resize(n, T());
-            data[i][i] = T(1); // Establece los elementos de la diagonal a 1.
+            data[i * ld_ + i] = T(1); // Establece los elementos de la diagonal a 1.
         }
     }
 
@@ -144,6 +173,7 @@ public:
             data = other.data;
             rows_ = other.rows_;
             cols_ = other.cols_;
+            ld_ = other.ld_;
         }
         return *this;
     }
@@ -154,8 +184,10 @@ public:
             data = std::move(other.data);
             rows_ = other.rows_;
             cols_ = other.cols_;
+            ld_ = other.ld_;
             other.rows_ = 0; // Deja la fuente en un estado válido y vacío.
             other.cols_ = 0;
+            other.ld_ = 0;
         }
         return *this;
     }
@@ -166,7 +198,7 @@ public:
         if (r >= rows_ || c >= cols_) {
             throw std::out_of_range("Error: Índice de matriz fuera de rango.");
         }
-        return data[r][c];
+        return data[r * ld_ + c];
     }
 
     // Acceso de lectura/escritura a un elemento (matriz[r][c]).
@@ -174,26 +206,35 @@ public:
         if (r >= rows_ || c >= cols_) {
             throw std::out_of_range("Error: Índice de matriz fuera de rango.");
         }
-        return data[r][c];
+        return data[r * ld_ + c];
     }
 
     // --- Métodos de Información y Extracción de Datos ---
     // Retorna una copia de todos los elementos de la matriz.
     std::vector<std::vector<T>> get_data() const {
-        return data;
+        std::vector<std::vector<T>> res(rows_);
+        for (std::size_t i = 0; i < rows_; ++i) {
+            res[i].assign(row_ptr(i), row_ptr(i) + cols_);
+        }
+        return res;
     }
 
     std::size_t rows() const { return rows_; } // Obtiene el número de filas.
     std::size_t cols() const { return cols_; } // Obtiene el número de columnas.
+    std::size_t leading_dim() const { return ld_; } // Distancia (en elementos) entre filas consecutivas.
 
     bool empty() const { return rows_ == 0 || cols_ == 0; } // Comprueba si la matriz está vacía.
 
+    // Acceso directo al bloque contiguo de elementos (por filas, con paso leading_dim()).
+    T* data_ptr() { return data.data(); }
+    const T* data_ptr() const { return data.data(); }
+
     // Retorna la fila especificada como un vector (por copia).
     std::vector<T> get_row(std::size_t r) const {
         if (r >= rows_) {
             throw std::out_of_range("Error: Índice de fila fuera de rango.");
         }
-        return data[r];
+        return std::vector<T>(row_ptr(r), row_ptr(r) + cols_);
     }
 
     // Retorna la columna especificada como un vector (por copia).
@@ -203,11 +244,52 @@ public:
         }
         std::vector<T> res(rows_);
         for (std::size_t i = 0; i < rows_; ++i) {
-            res[i] = data[i][c];
+            res[i] = data[i * ld_ + c];
         }
         return res;
     }
 
+    // --- Vistas (sin copia) sobre filas, columnas y bloques ---
+    // Vista 1 x cols() de la fila r.
+    MatrixView<T> row_view(std::size_t r) {
+        if (r >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango.");
+        }
+        return MatrixView<T>(row_ptr(r), 1, cols_, ld_);
+    }
+    MatrixView<const T> row_view(std::size_t r) const {
+        if (r >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango.");
+        }
+        return MatrixView<const T>(row_ptr(r), 1, cols_, ld_);
+    }
+
+    // Vista rows() x 1 de la columna c (paso leading_dim() entre elementos).
+    MatrixView<T> col_view(std::size_t c) {
+        if (c >= cols_) {
+            throw std::out_of_range("Error: Índice de columna fuera de rango.");
+        }
+        return MatrixView<T>(data.data() + c, rows_, 1, ld_);
+    }
+    MatrixView<const T> col_view(std::size_t c) const {
+        if (c >= cols_) {
+            throw std::out_of_range("Error: Índice de columna fuera de rango.");
+        }
+        return MatrixView<const T>(data.data() + c, rows_, 1, ld_);
+    }
+
+    // Vista de la submatriz que comienza en (r0, c0) con n_rows x n_cols elementos.
+    MatrixView<T> block(std::size_t r0, std::size_t c0, std::size_t n_rows, std::size_t n_cols) {
+        return view().block(r0, c0, n_rows, n_cols);
+    }
+    MatrixView<const T> block(std::size_t r0, std::size_t c0, std::size_t n_rows, std::size_t n_cols) const {
+        return view().block(r0, c0, n_rows, n_cols);
+    }
+
+    // Vista de la matriz completa.
+    MatrixView<T> view() { return MatrixView<T>(data.data(), rows_, cols_, ld_); }
+    MatrixView<const T> view() const { return MatrixView<const T>(data.data(), rows_, cols_, ld_); }
+
     // --- Métodos de Entrada/Salida ---
     void save(std::string filePath) const {
         std::ofstream myfile;
@@ -220,9 +302,9 @@ public:
         for (std::size_t i = 0; i < rows_; ++i) {
             for (std::size_t j = 0; j < cols_; ++j) {
                 if constexpr (std::is_floating_point_v<T>) {
-                    myfile << std::fixed << std::setw(11) << std::setprecision(6) << data[i][j];
+                    myfile << std::fixed << std::setw(11) << std::setprecision(6) << data[i * ld_ + j];
                 } else {
-                    myfile << data[i][j];
+                    myfile << data[i * ld_ + j];
                 }
 
                 if (j < cols_ - 1) {
@@ -240,8 +322,10 @@ public:
             throw std::invalid_argument("Error: Las matrices deben tener las mismas dimensiones para la suma.");
         }
         for (std::size_t i = 0; i < rows_; ++i) {
+            T* dst = row_ptr(i);
+            const T* src = other.row_ptr(i);
             for (std::size_t j = 0; j < cols_; ++j) {
-                data[i][j] += other(i, j);
+                dst[j] += src[j];
             }
         }
         return *this;
@@ -252,8 +336,10 @@ public:
             throw std::invalid_argument("Error: Las matrices deben tener las mismas dimensiones para la resta.");
         }
         for (std::size_t i = 0; i < rows_; ++i) {
+            T* dst = row_ptr(i);
+            const T* src = other.row_ptr(i);
             for (std::size_t j = 0; j < cols_; ++j) {
-                data[i][j] -= other(i, j);
+                dst[j] -= src[j];
             }
         }
         return *this;
@@ -261,9 +347,7 @@ public:
 
     Matrix<T>& operator*=(T scalar) {
         for (std::size_t i = 0; i < rows_; ++i) {
-            for (std::size_t j = 0; j < cols_; ++j) {
-                data[i][j] *= scalar;
-            }
+            multiply_row_by_scalar_internal(i, scalar);
         }
         return *this;
     }
@@ -393,13 +477,8 @@ Matrix<T> operator*(const Matrix<T>& a1, const Matrix<T>& b1) {
         throw std::invalid_argument("Error: Las dimensiones de las matrices no son compatibles para la multiplicación.");
     }
     Matrix<T> product_matrix(a1.rows(), b1.cols());
-    for (std::size_t i = 0; i < a1.rows(); ++i) {
-        for (std::size_t j = 0; j < b1.cols(); ++j) {
-            for (std::size_t k = 0; k < a1.cols(); ++k) {
-                product_matrix(i, j) += (a1(i, k) * b1(k, j));
-            }
-        }
-    }
+    // Producto por bloques con micro-kernel vectorizado (ver gemm.h).
+    gemm(T(1), a1.view(), b1.view(), product_matrix.view());
     return product_matrix;
 }
 
@@ -411,10 +490,12 @@ Matrix<T> transpose(const Matrix<T>& M) {
     std::size_t num_cols = M.cols();
 
     Matrix<T> transposed_matrix(num_cols, num_rows);
+    MatrixView<const T> src = M.view();
+    MatrixView<T> dst = transposed_matrix.view();
 
     for (std::size_t i = 0; i < num_rows; ++i) {
         for (std::size_t j = 0; j < num_cols; ++j) {
-            transposed_matrix(j, i) = M(i, j);
+            dst(j, i) = src(i, j);
         }
     }
     return transposed_matrix;
@@ -0,0 +1,76 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <vector>      // Para std::vector
+#include <stdexcept>   // Para std::out_of_range
+#include <type_traits> // Para std::remove_const_t, std::enable_if_t
+
+/* --- MatrixView Class Declaration --- */
+// Vista no propietaria (no copia ni libera memoria) sobre un bloque de elementos
+// almacenados con pasos (strides) arbitrarios. Sirve para representar filas, columnas
+// y submatrices de una Matrix<T> sin copiarlas. Para vistas de solo lectura se usa
+// MatrixView<const T>. La vista deja de ser válida si la matriz original se destruye
+// o cambia de tamaño.
+template <class T>
+class MatrixView
+{
+private:
+    T* ptr_ = nullptr;            // Puntero al elemento (0, 0) de la vista.
+    std::size_t rows_ = 0;        // Número de filas de la vista.
+    std::size_t cols_ = 0;        // Número de columnas de la vista.
+    std::size_t row_stride_ = 0;  // Distancia (en elementos) entre filas consecutivas.
+    std::size_t col_stride_ = 1;  // Distancia (en elementos) entre columnas consecutivas.
+
+public:
+    using value_type = std::remove_const_t<T>;
+
+    MatrixView() = default;
+    MatrixView(T* ptr, std::size_t rows, std::size_t cols, std::size_t row_stride, std::size_t col_stride = 1)
+        : ptr_(ptr), rows_(rows), cols_(cols), row_stride_(row_stride), col_stride_(col_stride) {}
+
+    // Conversión implícita de vista mutable a vista de solo lectura.
+    template <class U, class = std::enable_if_t<std::is_same_v<const U, T>>>
+    MatrixView(const MatrixView<U>& other)
+        : ptr_(other.data()), rows_(other.rows()), cols_(other.cols()),
+          row_stride_(other.row_stride()), col_stride_(other.col_stride()) {}
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t size() const { return rows_ * cols_; }
+    std::size_t row_stride() const { return row_stride_; }
+    std::size_t col_stride() const { return col_stride_; }
+    T* data() const { return ptr_; }
+    bool empty() const { return rows_ == 0 || cols_ == 0; }
+
+    // Acceso sin comprobación de rango (las vistas se usan en los bucles internos).
+    T& operator()(std::size_t r, std::size_t c) const {
+        return ptr_[r * row_stride_ + c * col_stride_];
+    }
+
+    // Acceso lineal para vistas de una sola fila o una sola columna.
+    T& operator[](std::size_t i) const {
+        return (rows_ == 1) ? ptr_[i * col_stride_] : ptr_[i * row_stride_];
+    }
+
+    // Submatriz de la vista: comienza en (r0, c0) y tiene n_rows x n_cols elementos.
+    MatrixView<T> block(std::size_t r0, std::size_t c0, std::size_t n_rows, std::size_t n_cols) const {
+        if (r0 + n_rows > rows_ || c0 + n_cols > cols_) {
+            throw std::out_of_range("Error: Bloque fuera de rango en MatrixView::block.");
+        }
+        return MatrixView<T>(ptr_ + r0 * row_stride_ + c0 * col_stride_, n_rows, n_cols, row_stride_, col_stride_);
+    }
+
+    // Copia los elementos de la vista en un std::vector (recorrido por filas).
+    std::vector<value_type> to_vector() const {
+        std::vector<value_type> res;
+        res.reserve(size());
+        for (std::size_t i = 0; i < rows_; ++i) {
+            for (std::size_t j = 0; j < cols_; ++j) {
+                res.push_back((*this)(i, j));
+            }
+        }
+        return res;
+    }
+};
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <vector>      // Para std::vector (buffers de empaquetado)
+#include <algorithm>   // Para std::min
+#include <cstddef>     // Para std::size_t
+#include <type_traits> // Para std::is_same_v
+#include <stdexcept>   // Para std::invalid_argument
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h> // Intrínsecos AVX2/FMA
+#define GEMM_USE_AVX2 1
+#endif
+
+#include "MatrixView.h"
+
+/* --- Producto de matrices por bloques (GEMM) --- */
+// Calcula C += alpha * A * B siguiendo el esquema clásico de GotoBLAS:
+//   1. B se divide en paneles de KC x NC que se empaquetan en tiras de NR columnas (caben en L1).
+//   2. A se divide en bloques de MC x KC que se empaquetan en tiras de MR filas (caben en L2).
+//   3. Un micro-kernel calcula cada tesela MR x NR de C manteniendo los acumuladores en registros.
+// Para double y float se usa un micro-kernel AVX2/FMA cuando el compilador lo habilita
+// (-mavx2 -mfma o -march=native). Para cualquier otro T (Complex, Rational, Dual, ...)
+// se usa el mismo esquema de bloques con un micro-kernel escalar genérico.
+
+// Tamaños de bloque y de tesela para cada tipo. MC debe ser múltiplo de MR y NC de NR.
+template <class T>
+struct gemm_block_sizes
+{
+    static constexpr std::size_t MR = 4;
+    static constexpr std::size_t NR = 4;
+    static constexpr std::size_t MC = 64;
+    static constexpr std::size_t KC = 128;
+    static constexpr std::size_t NC = 1024;
+};
+
+template <>
+struct gemm_block_sizes<double>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 8;
+    static constexpr std::size_t MC = 96;
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t NC = 2048;
+};
+
+template <>
+struct gemm_block_sizes<float>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 16;
+    static constexpr std::size_t MC = 96;
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t NC = 4096;
+};
+
+// Por debajo de este número de multiplicaciones (m * n * k) el costo de empaquetar
+// supera la ganancia y se usa el bucle directo i-k-j.
+inline constexpr std::size_t gemm_small_threshold = 32 * 32 * 32;
+
+// Empaqueta el bloque A(i0:i0+mc, p0:p0+kc), escalado por alpha, en tiras de MR filas.
+// Dentro de cada tira los elementos quedan ordenados por k: a[p * MR + r].
+// Las filas que faltan en la última tira se rellenan con ceros.
+template <class T, std::size_t MR>
+void gemm_pack_a(const MatrixView<const T>& A, std::size_t i0, std::size_t p0,
+                 std::size_t mc, std::size_t kc, T alpha, T* packed) {
+    for (std::size_t ir = 0; ir < mc; ir += MR) {
+        const std::size_t mr = std::min(MR, mc - ir);
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t r = 0; r < mr; ++r) {
+                packed[p * MR + r] = alpha * A(i0 + ir + r, p0 + p);
+            }
+            for (std::size_t r = mr; r < MR; ++r) {
+                packed[p * MR + r] = T();
+            }
+        }
+        packed += kc * MR;
+    }
+}
+
+// Empaqueta el panel B(p0:p0+kc, j0:j0+nc) en tiras de NR columnas: b[p * NR + c].
+template <class T, std::size_t NR>
+void gemm_pack_b(const MatrixView<const T>& B, std::size_t p0, std::size_t j0,
+                 std::size_t kc, std::size_t nc, T* packed) {
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+        const std::size_t nr = std::min(NR, nc - jr);
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t c = 0; c < nr; ++c) {
+                packed[p * NR + c] = B(p0 + p, j0 + jr + c);
+            }
+            for (std::size_t c = nr; c < NR; ++c) {
+                packed[p * NR + c] = T();
+            }
+        }
+        packed += kc * NR;
+    }
+}
+
+// Micro-kernel genérico: acc = sum_p a[p, :] (x) b[p, :] sobre una tesela MR x NR.
+// El resultado se deja en 'acc' (ordenado por filas); quien llama lo suma a C.
+template <class T, std::size_t MR, std::size_t NR>
+void gemm_micro_kernel(std::size_t kc, const T* a, const T* b, T* acc) {
+    for (std::size_t i = 0; i < MR * NR; ++i) {
+        acc[i] = T();
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        for (std::size_t r = 0; r < MR; ++r) {
+            const T a_r = a[r];
+            for (std::size_t c = 0; c < NR; ++c) {
+                acc[r * NR + c] += a_r * b[c];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+}
+
+#ifdef GEMM_USE_AVX2
+// Micro-kernel 6 x 8 para double: 12 registros ymm de acumuladores, 2 para B y 1 para A.
+template <>
+inline void gemm_micro_kernel<double, 6, 8>(std::size_t kc, const double* a, const double* b, double* acc) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+    for (std::size_t p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ar;
+        ar = _mm256_broadcast_sd(a + 0); c00 = _mm256_fmadd_pd(ar, b0, c00); c01 = _mm256_fmadd_pd(ar, b1, c01);
+        ar = _mm256_broadcast_sd(a + 1); c10 = _mm256_fmadd_pd(ar, b0, c10); c11 = _mm256_fmadd_pd(ar, b1, c11);
+        ar = _mm256_broadcast_sd(a + 2); c20 = _mm256_fmadd_pd(ar, b0, c20); c21 = _mm256_fmadd_pd(ar, b1, c21);
+        ar = _mm256_broadcast_sd(a + 3); c30 = _mm256_fmadd_pd(ar, b0, c30); c31 = _mm256_fmadd_pd(ar, b1, c31);
+        ar = _mm256_broadcast_sd(a + 4); c40 = _mm256_fmadd_pd(ar, b0, c40); c41 = _mm256_fmadd_pd(ar, b1, c41);
+        ar = _mm256_broadcast_sd(a + 5); c50 = _mm256_fmadd_pd(ar, b0, c50); c51 = _mm256_fmadd_pd(ar, b1, c51);
+        a += 6;
+        b += 8;
+    }
+
+    _mm256_storeu_pd(acc + 0,  c00); _mm256_storeu_pd(acc + 4,  c01);
+    _mm256_storeu_pd(acc + 8,  c10); _mm256_storeu_pd(acc + 12, c11);
+    _mm256_storeu_pd(acc + 16, c20); _mm256_storeu_pd(acc + 20, c21);
+    _mm256_storeu_pd(acc + 24, c30); _mm256_storeu_pd(acc + 28, c31);
+    _mm256_storeu_pd(acc + 32, c40); _mm256_storeu_pd(acc + 36, c41);
+    _mm256_storeu_pd(acc + 40, c50); _mm256_storeu_pd(acc + 44, c51);
+}
+
+// Micro-kernel 6 x 16 para float (misma forma, 8 elementos por registro).
+template <>
+inline void gemm_micro_kernel<float, 6, 16>(std::size_t kc, const float* a, const float* b, float* acc) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (std::size_t p = 0; p < kc; ++p) {
+        const __m256 b0 = _mm256_loadu_ps(b);
+        const __m256 b1 = _mm256_loadu_ps(b + 8);
+        __m256 ar;
+        ar = _mm256_broadcast_ss(a + 0); c00 = _mm256_fmadd_ps(ar, b0, c00); c01 = _mm256_fmadd_ps(ar, b1, c01);
+        ar = _mm256_broadcast_ss(a + 1); c10 = _mm256_fmadd_ps(ar, b0, c10); c11 = _mm256_fmadd_ps(ar, b1, c11);
+        ar = _mm256_broadcast_ss(a + 2); c20 = _mm256_fmadd_ps(ar, b0, c20); c21 = _mm256_fmadd_ps(ar, b1, c21);
+        ar = _mm256_broadcast_ss(a + 3); c30 = _mm256_fmadd_ps(ar, b0, c30); c31 = _mm256_fmadd_ps(ar, b1, c31);
+        ar = _mm256_broadcast_ss(a + 4); c40 = _mm256_fmadd_ps(ar, b0, c40); c41 = _mm256_fmadd_ps(ar, b1, c41);
+        ar = _mm256_broadcast_ss(a + 5); c50 = _mm256_fmadd_ps(ar, b0, c50); c51 = _mm256_fmadd_ps(ar, b1, c51);
+        a += 6;
+        b += 16;
+    }
+
+    _mm256_storeu_ps(acc + 0,  c00); _mm256_storeu_ps(acc + 8,  c01);
+    _mm256_storeu_ps(acc + 16, c10); _mm256_storeu_ps(acc + 24, c11);
+    _mm256_storeu_ps(acc + 32, c20); _mm256_storeu_ps(acc + 40, c21);
+    _mm256_storeu_ps(acc + 48, c30); _mm256_storeu_ps(acc + 56, c31);
+    _mm256_storeu_ps(acc + 64, c40); _mm256_storeu_ps(acc + 72, c41);
+    _mm256_storeu_ps(acc + 80, c50); _mm256_storeu_ps(acc + 88, c51);
+}
+#endif
+
+// Bucle directo i-k-j para matrices pequeñas (sin empaquetar).
+template <class T>
+void gemm_small(T alpha, const MatrixView<const T>& A, const MatrixView<const T>& B, const MatrixView<T>& C) {
+    for (std::size_t i = 0; i < A.rows(); ++i) {
+        for (std::size_t p = 0; p < A.cols(); ++p) {
+            const T a_ip = alpha * A(i, p);
+            for (std::size_t j = 0; j < B.cols(); ++j) {
+                C(i, j) += a_ip * B(p, j);
+            }
+        }
+    }
+}
+
+// C += alpha * A * B. Las tres vistas pueden tener pasos arbitrarios (filas, columnas o
+// bloques de otras matrices), pero C no debe solaparse con A ni con B.
+template <class T>
+void gemm(T alpha, const MatrixView<const T>& A, const MatrixView<const T>& B, const MatrixView<T>& C) {
+    if (A.cols() != B.rows() || A.rows() != C.rows() || B.cols() != C.cols()) {
+        throw std::invalid_argument("Error: Las dimensiones de las matrices no son compatibles para gemm.");
+    }
+    const std::size_t m = A.rows();
+    const std::size_t n = B.cols();
+    const std::size_t k = A.cols();
+    if (m == 0 || n == 0 || k == 0) return;
+
+    if (m * n * k <= gemm_small_threshold) {
+        gemm_small(alpha, A, B, C);
+        return;
+    }
+
+    using BS = gemm_block_sizes<T>;
+    constexpr std::size_t MR = BS::MR, NR = BS::NR, MC = BS::MC, KC = BS::KC, NC = BS::NC;
+
+    std::vector<T> packed_a(MC * KC);
+    std::vector<T> packed_b(KC * ((std::min(NC, n) + NR - 1) / NR) * NR);
+    T acc[MR * NR];
+
+    for (std::size_t jc = 0; jc < n; jc += NC) {
+        const std::size_t nc = std::min(NC, n - jc);
+        for (std::size_t pc = 0; pc < k; pc += KC) {
+            const std::size_t kc = std::min(KC, k - pc);
+            gemm_pack_b<T, NR>(B, pc, jc, kc, nc, packed_b.data());
+
+            for (std::size_t ic = 0; ic < m; ic += MC) {
+                const std::size_t mc = std::min(MC, m - ic);
+                gemm_pack_a<T, MR>(A, ic, pc, mc, kc, alpha, packed_a.data());
+
+                for (std::size_t jr = 0; jr < nc; jr += NR) {
+                    const std::size_t nr = std::min(NR, nc - jr);
+                    const T* b_sliver = packed_b.data() + jr * kc;
+                    for (std::size_t ir = 0; ir < mc; ir += MR) {
+                        const std::size_t mr = std::min(MR, mc - ir);
+                        gemm_micro_kernel<T, MR, NR>(kc, packed_a.data() + ir * kc, b_sliver, acc);
+
+                        // Suma la tesela a C (solo la parte válida en los bordes).
+                        for (std::size_t r = 0; r < mr; ++r) {
+                            for (std::size_t c = 0; c < nr; ++c) {
+                                C(ic + ir + r, jc + jr + c) += acc[r * NR + c];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+#include "Matrix.h"
+
+using namespace std;
+
+// Producto ingenuo (triple bucle con acceso comprobado), como el operator* original.
+Matrix<double> producto_ingenuo(const Matrix<double>& a, const Matrix<double>& b)
+{
+    Matrix<double> c(a.rows(), b.cols());
+    for (size_t i = 0; i < a.rows(); ++i)
+        for (size_t j = 0; j < b.cols(); ++j)
+            for (size_t k = 0; k < a.cols(); ++k)
+                c(i, j) += a(i, k) * b(k, j);
+    return c;
+}
+
+Matrix<double> matriz_aleatoria(size_t n, mt19937& gen)
+{
+    uniform_real_distribution<> dis(-1.0, 1.0);
+    Matrix<double> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            m(i, j) = dis(gen);
+    return m;
+}
+
+// Mide el tiempo (en segundos) de la mejor de 'repeticiones' ejecuciones.
+template <class F>
+double medir(F&& f, int repeticiones)
+{
+    double mejor = 1e300;
+    for (int r = 0; r < repeticiones; ++r)
+    {
+        auto inicio = chrono::steady_clock::now();
+        f();
+        auto fin = chrono::steady_clock::now();
+        mejor = min(mejor, chrono::duration<double>(fin - inicio).count());
+    }
+    return mejor;
+}
+
+int main(int argc, char* argv[])
+{
+    // El producto ingenuo solo se mide hasta este tamaño (por defecto 1024), porque
+    // para n = 4096 tarda varios minutos.
+    size_t n_max_ingenuo = (argc > 1) ? static_cast<size_t>(atoi(argv[1])) : 1024;
+
+    // Segundo argumento opcional: número de hilos del pool de matrices.
+    if (argc > 2) set_matrix_num_threads(static_cast<size_t>(atoi(argv[2])));
+
+    mt19937 gen(42);
+    cout << "Hilos: " << matrix_num_threads() << endl;
+    cout << setw(6) << "n" << setw(16) << "ingenuo GF/s" << setw(16) << "gemm GF/s" << setw(12) << "speedup" << endl;
+
+    for (size_t n = 64; n <= 4096; n *= 2)
+    {
+        Matrix<double> A = matriz_aleatoria(n, gen);
+        Matrix<double> B = matriz_aleatoria(n, gen);
+        double flops = 2.0 * n * n * n;
+        int repeticiones = (n <= 512) ? 5 : 1;
+
+        double t_gemm = medir([&] { Matrix<double> C = A * B; }, repeticiones);
+        double gf_gemm = flops / t_gemm * 1e-9;
+
+        cout << setw(6) << n << fixed << setprecision(2);
+        if (n <= n_max_ingenuo)
+        {
+            double t_ingenuo = medir([&] { Matrix<double> C = producto_ingenuo(A, B); }, repeticiones);
+            double gf_ingenuo = flops / t_ingenuo * 1e-9;
+            cout << setw(16) << gf_ingenuo << setw(16) << gf_gemm << setw(11) << gf_gemm / gf_ingenuo << "x";
+        }
+        else
+        {
+            cout << setw(16) << "-" << setw(16) << gf_gemm << setw(12) << "-";
+        }
+        cout << endl;
+    }
+    return 0;
+}
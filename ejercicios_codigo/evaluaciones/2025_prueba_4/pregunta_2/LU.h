@@ -0,0 +1,243 @@
+#ifndef LU_H
+#define LU_H
+
+#include <vector>      // Para std::vector
+#include <cmath>       // Para std::abs
+#include <limits>      // Para std::numeric_limits
+#include <type_traits> // Para std::is_floating_point_v
+#include <stdexcept>   // Para std::invalid_argument, std::runtime_error
+#include <algorithm>   // Para std::swap_ranges, std::max
+#include <cstddef>     // Para std::size_t
+
+#include "Matrix.h"
+
+/* --- LU Class Declaration --- */
+// Factorización PA = LU con pivoteo parcial por filas. Los factores se calculan una sola
+// vez en el constructor (O(n³)) y después cada solve() cuesta solo dos sustituciones
+// triangulares (O(n²) por lado derecho). L (diagonal unitaria, no almacenada) y U se
+// guardan juntas en una sola matriz, y la permutación P en un vector de índices.
+//
+// Para tipos de punto flotante el pivote es el de mayor valor absoluto de la columna,
+// igual que en gauss_elimination. Para los demás tipos (Complex, Rational...) se deja el
+// elemento de la diagonal si no es nulo y solo si lo es se busca el primero no nulo de
+// abajo; gauss_elimination en cambio intercambia siempre con el primero no nulo de abajo.
+// Con aritmética exacta cualquier pivote no nulo sirve, así se evitan intercambios.
+template <class T>
+class LU
+{
+private:
+    Matrix<T> lu_;                    // L (bajo la diagonal) y U (diagonal y encima).
+    std::vector<std::size_t> perm_;   // perm_[i] = fila de A que terminó en la fila i.
+    int swap_count_ = 0;              // Número de intercambios de filas (signo del determinante).
+    bool singular_ = false;           // true si algún pivote resultó (casi) nulo.
+
+    static bool is_zero_pivot(const T& value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::abs(value) < std::numeric_limits<T>::epsilon() * 100;
+        } else {
+            return value == T();
+        }
+    }
+
+    std::size_t find_pivot_row(std::size_t k) const {
+        const std::size_t n = lu_.rows();
+        const T* a = lu_.data_ptr();
+        const std::size_t ld = lu_.leading_dim();
+        std::size_t pivot_row = k;
+        if constexpr (std::is_floating_point_v<T>) {
+            for (std::size_t i = k + 1; i < n; ++i) {
+                if (std::abs(a[i * ld + k]) > std::abs(a[pivot_row * ld + k])) {
+                    pivot_row = i;
+                }
+            }
+        } else {
+            if (a[k * ld + k] == T()) {
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    if (a[i * ld + k] != T()) {
+                        pivot_row = i;
+                        break;
+                    }
+                }
+            }
+        }
+        return pivot_row;
+    }
+
+    void factorize() {
+        const std::size_t n = lu_.rows();
+        T* a = lu_.data_ptr();
+        const std::size_t ld = lu_.leading_dim();
+
+        for (std::size_t k = 0; k < n; ++k) {
+            // 1. Pivoteo parcial.
+            const std::size_t pivot_row = find_pivot_row(k);
+            if (pivot_row != k) {
+                std::swap_ranges(a + k * ld, a + k * ld + n, a + pivot_row * ld);
+                std::swap(perm_[k], perm_[pivot_row]);
+                ++swap_count_;
+            }
+
+            const T pivot_value = a[k * ld + k];
+            if (is_zero_pivot(pivot_value)) {
+                singular_ = true;
+                continue; // No hay nada que eliminar con un pivote nulo.
+            }
+
+            // 2. Multiplicadores (columna k de L) y actualización del bloque restante.
+            // Las filas son independientes entre sí y se reparten entre los hilos.
+            auto update_rows = [&](std::size_t first, std::size_t last) {
+                const T* row_k = a + k * ld;
+                for (std::size_t i = first; i < last; ++i) {
+                    T* row_i = a + i * ld;
+                    const T factor = row_i[k] / pivot_value;
+                    row_i[k] = factor;
+                    for (std::size_t j = k + 1; j < n; ++j) {
+                        row_i[j] = row_i[j] - factor * row_k[j];
+                    }
+                }
+            };
+            const std::size_t trailing = n - (k + 1);
+            if (trailing * trailing < matrix_parallel_threshold) {
+                update_rows(k + 1, n);
+            } else {
+                const std::size_t grain = std::max<std::size_t>(1, matrix_parallel_threshold / (4 * trailing));
+                matrix_thread_pool().parallel_for(k + 1, n, grain, update_rows);
+            }
+        }
+    }
+
+    void check_solvable(std::size_t rhs_rows) const {
+        if (rhs_rows != lu_.rows()) {
+            throw std::invalid_argument("Error: El lado derecho no tiene el mismo número de filas que la matriz factorizada.");
+        }
+        if (singular_) {
+            throw std::runtime_error("Error: La matriz es singular o casi singular. No se puede resolver el sistema.");
+        }
+    }
+
+public:
+    LU() = default;
+
+    // Factoriza la matriz cuadrada A.
+    explicit LU(const Matrix<T>& A) : lu_(A) {
+        if (A.rows() != A.cols()) {
+            throw std::invalid_argument("Error: La factorización LU solo se puede calcular para matrices cuadradas.");
+        }
+        perm_.resize(A.rows());
+        for (std::size_t i = 0; i < perm_.size(); ++i) {
+            perm_[i] = i;
+        }
+        factorize();
+    }
+
+    std::size_t size() const { return lu_.rows(); }
+    bool is_singular() const { return singular_; }
+    const Matrix<T>& factors() const { return lu_; }                 // L y U empaquetadas.
+    const std::vector<std::size_t>& permutation() const { return perm_; }
+
+    // Determinante: producto de la diagonal de U con el signo de la permutación. O(n).
+    T determinant() const {
+        if (lu_.empty()) return T(0);
+        T det_value = ((swap_count_ % 2) != 0) ? T(-1) : T(1);
+        for (std::size_t i = 0; i < lu_.rows(); ++i) {
+            det_value = det_value * lu_(i, i);
+        }
+        return det_value;
+    }
+
+    // Resuelve A X = B para todas las columnas de B a la vez.
+    // Las sustituciones se hacen por filas completas de X, que son contiguas en memoria.
+    // (Se escribe x = x - y en lugar de -= para admitir tipos como Complex o Rational.)
+    Matrix<T> solve(const Matrix<T>& B) const {
+        check_solvable(B.rows());
+        const std::size_t n = lu_.rows();
+        const std::size_t m = B.cols();
+        const T* a = lu_.data_ptr();
+        const std::size_t ld = lu_.leading_dim();
+
+        // X = P B
+        Matrix<T> X(n, m);
+        for (std::size_t i = 0; i < n; ++i) {
+            const T* src = B.data_ptr() + perm_[i] * B.leading_dim();
+            std::copy(src, src + m, X.data_ptr() + i * X.leading_dim());
+        }
+        T* x = X.data_ptr();
+        const std::size_t ldx = X.leading_dim();
+
+        // Sustitución hacia adelante: L Y = P B (L con diagonal unitaria).
+        for (std::size_t i = 1; i < n; ++i) {
+            T* x_i = x + i * ldx;
+            for (std::size_t k = 0; k < i; ++k) {
+                const T l_ik = a[i * ld + k];
+                const T* x_k = x + k * ldx;
+                for (std::size_t j = 0; j < m; ++j) {
+                    x_i[j] = x_i[j] - l_ik * x_k[j];
+                }
+            }
+        }
+
+        // Sustitución hacia atrás: U X = Y.
+        for (std::size_t i = n; i-- > 0;) {
+            T* x_i = x + i * ldx;
+            for (std::size_t k = i + 1; k < n; ++k) {
+                const T u_ik = a[i * ld + k];
+                const T* x_k = x + k * ldx;
+                for (std::size_t j = 0; j < m; ++j) {
+                    x_i[j] = x_i[j] - u_ik * x_k[j];
+                }
+            }
+            const T inv_pivot = T(1) / a[i * ld + i];
+            for (std::size_t j = 0; j < m; ++j) {
+                x_i[j] = x_i[j] * inv_pivot;
+            }
+        }
+        return X;
+    }
+
+    // Resuelve A x = b para un solo lado derecho.
+    std::vector<T> solve(const std::vector<T>& b) const {
+        check_solvable(b.size());
+        const std::size_t n = lu_.rows();
+        const T* a = lu_.data_ptr();
+        const std::size_t ld = lu_.leading_dim();
+
+        std::vector<T> x(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = b[perm_[i]];
+        }
+        for (std::size_t i = 1; i < n; ++i) {
+            T sum = x[i];
+            for (std::size_t k = 0; k < i; ++k) {
+                sum = sum - a[i * ld + k] * x[k];
+            }
+            x[i] = sum;
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            T sum = x[i];
+            for (std::size_t k = i + 1; k < n; ++k) {
+                sum = sum - a[i * ld + k] * x[k];
+            }
+            x[i] = sum / a[i * ld + i];
+        }
+        return x;
+    }
+
+    // Versión para la clase Vector<T> de la biblioteca.
+    Vector<T> solve(const Vector<T>& b) const {
+        std::vector<T> rhs(b.size());
+        for (std::size_t i = 0; i < b.size(); ++i) {
+            rhs[i] = b[i];
+        }
+        return Vector<T>(solve(rhs));
+    }
+
+    // Inversa de A: resuelve A X = I con todas las columnas de la identidad a la vez.
+    Matrix<T> inverse() const {
+        if (singular_) {
+            throw std::runtime_error("Error: La matriz es singular o casi singular. No se puede calcular la inversa.");
+        }
+        return solve(Matrix<T>(lu_.rows()));
+    }
+};
+
+#endif
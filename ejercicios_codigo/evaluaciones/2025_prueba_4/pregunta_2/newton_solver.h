@@ -9,6 +9,7 @@
 #include <limits>     // Para std::numeric_limits
 
 #include "Matrix.h"
+#include "LU.h"
 
 template <typename T>
 class NewtonSolver
@@ -56,17 +57,19 @@ std::vector<T> NewtonSolver<T>::solve(
         std::vector<T> f_val = F(x);
         Matrix<T> J_val = Jacobian(x);
 
+        // Se factoriza el Jacobiano una sola vez: el determinante y la solución del
+        // sistema J * delta_x = F salen de los mismos factores LU (sin formar la inversa).
+        LU<T> J_lu(J_val);
+
         // Verificación de singularidad del Jacobiano
-        T det_J = determinante(J_val);
+        T det_J = J_lu.determinant();
         if (std::abs(det_J) < std::numeric_limits<T>::epsilon() * 1e3)
         {
             std::cerr << "Advertencia: Jacobiano casi singular en la iteración " << i << ". Determinante: " << det_J << std::endl;
         }
 
-        Matrix<T> J_inv = inversa(J_val);
-
-        // Cálculo de delta_x = J(x_n)^-1 * F(x_n)
-        delta_x = J_inv * f_val;
+        // Cálculo de delta_x resolviendo J(x_n) * delta_x = F(x_n)
+        delta_x = J_lu.solve(f_val);
 
         // Actualización de x: x_{n+1} = x_n - delta_x
         for (int j = 0; j < dimension; ++j) {
@@ -74,7 +77,11 @@ std::vector<T> NewtonSolver<T>::solve(
         }
 
         // Criterio de convergencia: ||delta_x|| < tolerancia
-        T current_norm = norm2(delta_x);
+        T current_norm = T();
+        for (int j = 0; j < dimension; ++j) {
+            current_norm += delta_x[j] * delta_x[j];
+        }
+        current_norm = std::sqrt(current_norm);
         std::cout << "Iteracion " << i + 1 << ": x = " << x << ", ||delta_x|| = " << current_norm << std::endl;
 
         if (current_norm < tolerance)
@@ -1,7 +1,9 @@
 #include <iostream>
 #include <iomanip>
 #include <random>
+#include <vector>
 #include "eqns_cat.h"
+#include "montecarlo_nd.h"
 
 const double PI = 3.14159265358979323846;
 
@@ -37,5 +39,19 @@ int main()
     cout << fixed << setprecision(2);
     cout << "El area aproximada es: " << area_aproximada << endl;
 
+    // Lo mismo con MonteCarloIntegratorND: con la secuencia de Sobol (aleatorizada) el
+    // error baja casi como 1/N y basta con muchas menos muestras. 16 replicas de 2^14
+    // puntos cada una dan ademas una estimacion del error.
+    MonteCarloIntegratorND integrador({0.0}, {2.0 * PI});
+    auto integrando = [](const vector<double>& t) { return integrando_area_gato(t[0]); };
+    const long long muestras_qmc = 16 * (1 << 14);
+    ResultadoMonteCarlo mc = integrador.aproximar(integrando, muestras_qmc, Muestreo::PSEUDOALEATORIO, 2025);
+    ResultadoMonteCarlo qmc = integrador.aproximar(integrando, muestras_qmc, Muestreo::SOBOL, 2025);
+    cout << setprecision(6);
+    cout << "Con " << muestras_qmc << " muestras:" << endl;
+    cout << "  pseudoaleatorio: " << mc.valor << " +- " << scientific << setprecision(1) << mc.error << endl;
+    cout << fixed << setprecision(6);
+    cout << "  Sobol:           " << qmc.valor << " +- " << scientific << setprecision(1) << qmc.error << endl;
+
     return 0;
 }
\ No newline at end of file
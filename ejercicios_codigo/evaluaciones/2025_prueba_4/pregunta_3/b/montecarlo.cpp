@@ -1,6 +1,13 @@
 #include "montecarlo.h"
+#include "philox.h"
 #include <random>
 #include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 double MonteCarloIntegrator::aproximar(
     double a,
@@ -15,18 +22,148 @@ double MonteCarloIntegrator::aproximar(
     }
 
     std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(a, b);
+    PhiloxStream gen((std::uint64_t(rd()) << 32) | rd());
 
+    // los puntos se generan por lotes (ver philox.h) y despues se evalua func
+    const long long lote = 256;
+    double puntos[lote];
     double suma_total = 0.0;
-    for (long long i = 0; i < num_muestras; ++i)
+    for (long long i = 0; i < num_muestras; i += lote)
     {
-        double punto_aleatorio = dis(gen);
-        suma_total += func(punto_aleatorio);
+        const long long m = std::min(lote, num_muestras - i);
+        gen.uniformes(puntos, std::size_t(m), a, b);
+        for (long long j = 0; j < m; ++j)
+            suma_total += func(puntos[j]);
     }
 
     double valor_promedio = suma_total / num_muestras;
     double intervalo = b - a;
 
     return intervalo * valor_promedio;
-}
\ No newline at end of file
+}
+
+namespace
+{
+    // Muestras de un bloque: cada bloque tiene su flujo y su suma parcial propios.
+    const long long muestras_por_bloque = 1 << 14;
+    const long long lote = 256;
+
+    // Estadisticas de un conjunto de valores: cantidad, media y suma de los cuadrados de
+    // las desviaciones respecto de la media (se combinan sin restar sumas grandes).
+    struct Parcial
+    {
+        long long n = 0;
+        double media = 0.0;
+        double m2 = 0.0;
+    };
+
+    // Chan, Golub y LeVeque: estadisticas de la union de dos conjuntos.
+    Parcial combinar(const Parcial& x, const Parcial& y)
+    {
+        if (x.n == 0) return y;
+        if (y.n == 0) return x;
+        Parcial r;
+        r.n = x.n + y.n;
+        const double delta = y.media - x.media;
+        const double fy = double(y.n) / double(r.n);
+        r.media = x.media + delta * fy;
+        r.m2 = x.m2 + y.m2 + delta * delta * double(x.n) * fy;
+        return r;
+    }
+
+    // Suma por pares de partes[i, j): el error de redondeo crece como log(j - i).
+    Parcial combinarPorPares(const std::vector<Parcial>& partes, std::size_t i, std::size_t j)
+    {
+        if (j - i == 1) return partes[i];
+        const std::size_t mitad = i + (j - i) / 2;
+        return combinar(combinarPorPares(partes, i, mitad), combinarPorPares(partes, mitad, j));
+    }
+
+    // Un bloque: lotes de puntos uniformes en (a, b); cada lote con dos pasadas (media y
+    // desviaciones) y los lotes se combinan en orden.
+    Parcial muestrearBloque(double a, double b, long long n, const std::function<double(double)>& func,
+                            std::uint64_t semilla, std::uint64_t bloque)
+    {
+        PhiloxStream gen(semilla, bloque);
+        double valores[lote];
+        Parcial total;
+        for (long long i = 0; i < n; i += lote)
+        {
+            const long long m = std::min(lote, n - i);
+            gen.uniformes(valores, std::size_t(m), a, b);
+            double suma = 0.0;
+            for (long long j = 0; j < m; ++j)
+            {
+                valores[j] = func(valores[j]);
+                suma += valores[j];
+            }
+            Parcial parte;
+            parte.n = m;
+            parte.media = suma / double(m);
+            for (long long j = 0; j < m; ++j)
+            {
+                const double d = valores[j] - parte.media;
+                parte.m2 += d * d;
+            }
+            total = combinar(total, parte);
+        }
+        return total;
+    }
+}
+
+ResultadoMonteCarlo MonteCarloIntegrator::aproximar_paralelo(
+    double a,
+    double b,
+    long long num_muestras,
+    const std::function<double(double)>& func,
+    std::uint64_t semilla,
+    unsigned num_hilos)
+{
+    ResultadoMonteCarlo resultado;
+    if (a >= b)
+    {
+        std::cerr << "Error: El límite inferior 'a' debe ser menor que 'b'." << std::endl;
+        return resultado;
+    }
+    if (num_muestras <= 0)
+    {
+        std::cerr << "Error: El número de muestras debe ser positivo." << std::endl;
+        return resultado;
+    }
+
+    const auto inicio = std::chrono::steady_clock::now();
+    const std::size_t num_bloques = std::size_t((num_muestras + muestras_por_bloque - 1) / muestras_por_bloque);
+    std::vector<Parcial> partes(num_bloques);
+
+    // los bloques se reparten entre los hilos; cada uno escribe solo su propia entrada
+    std::atomic<std::size_t> siguiente{0};
+    auto trabajador = [&]
+    {
+        for (std::size_t k = siguiente.fetch_add(1); k < num_bloques; k = siguiente.fetch_add(1))
+        {
+            const long long primera = (long long)k * muestras_por_bloque;
+            const long long n = std::min(muestras_por_bloque, num_muestras - primera);
+            partes[k] = muestrearBloque(a, b, n, func, semilla, k);
+        }
+    };
+    std::size_t hilos = num_hilos;
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    hilos = std::min(hilos, num_bloques);
+    std::vector<std::thread> auxiliares;
+    for (std::size_t t = 1; t < hilos; ++t) auxiliares.emplace_back(trabajador);
+    trabajador();
+    for (std::thread& h : auxiliares) h.join();
+
+    const Parcial total = combinarPorPares(partes, 0, num_bloques);
+    const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    // integral = (b - a) <f>, con error estandar (b - a) s / sqrt(N)
+    const double intervalo = b - a;
+    const double N = double(total.n);
+    const double varianza = (total.n > 1) ? total.m2 / (N - 1.0) : 0.0;
+    resultado.valor = intervalo * total.media;
+    resultado.error = intervalo * std::sqrt(varianza / N);
+    resultado.muestras = total.n;
+    resultado.muestras_por_segundo = (segundos > 0.0) ? N / segundos : 0.0;
+    return resultado;
+}
@@ -2,6 +2,16 @@
 #define MONTECARLO_INTEGRATOR_H
 
 #include <functional>
+#include <cstdint>
+
+// Resultado de una integracion por Monte Carlo con su incertidumbre.
+struct ResultadoMonteCarlo
+{
+    double valor = 0.0;                // estimacion de la integral
+    double error = 0.0;                // error estandar de 'valor'
+    long long muestras = 0;
+    double muestras_por_segundo = 0.0; // muestras / tiempo de pared
+};
 
 class MonteCarloIntegrator
 {
@@ -14,6 +24,20 @@ public:
         long long num_muestras,
         const std::function<double(double)>& func
     );
+
+    // Igual que aproximar, pero con varios hilos y reproducible: las muestras se
+    // reparten en bloques fijos, el bloque k usa el flujo (semilla, k) de PhiloxStream
+    // y las sumas parciales de los bloques se combinan por pares en un orden fijo. Con
+    // la misma semilla el resultado es idéntico bit a bit para cualquier num_hilos
+    // (0: todos los núcleos). 'func' se llama desde varios hilos a la vez.
+    ResultadoMonteCarlo aproximar_paralelo(
+        double a,
+        double b,
+        long long num_muestras,
+        const std::function<double(double)>& func,
+        std::uint64_t semilla,
+        unsigned num_hilos = 0
+    );
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,54 @@
+#ifndef MONTECARLO_ND_H
+#define MONTECARLO_ND_H
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "montecarlo.h"
+
+// Forma de generar los puntos de MonteCarloIntegratorND
+enum class Muestreo
+{
+    PSEUDOALEATORIO, // PhiloxStream, error ~ 1/sqrt(N)
+    HALTON,          // Halton con desplazamiento aleatorio (Cranley-Patterson) módulo 1
+    SOBOL            // Sobol con desplazamiento digital aleatorio (XOR), d <= 21
+};
+
+// Integral de f sobre el hiperrectángulo [a_0, b_0] x ... x [a_{d-1}, b_{d-1}].
+//
+// El error se estima con réplicas independientes: las N muestras se dividen en R
+// réplicas de N/R puntos, cada una con su propia aleatorización (su flujo de Philox,
+// o su desplazamiento de la secuencia de baja discrepancia), y
+//     valor = promedio de las R estimaciones,   error = desviación de ellas / sqrt(R).
+// Con QMC cada réplica es una estimación insesgada, así que el error es honesto aunque
+// la varianza de un solo punto ya no tenga sentido. Las réplicas se reparten entre los
+// hilos y se promedian en orden: con la misma semilla el resultado no depende de
+// num_hilos. 'f' se llama desde varios hilos a la vez.
+class MonteCarloIntegratorND
+{
+public:
+    using Funcion = std::function<double(const std::vector<double>&)>;
+
+private:
+    std::vector<double> a_, b_;
+
+public:
+    MonteCarloIntegratorND(const std::vector<double>& a, const std::vector<double>& b);
+
+    std::size_t dimension() const { return a_.size(); }
+
+    ResultadoMonteCarlo aproximar(
+        const Funcion& f,
+        long long num_muestras,
+        Muestreo muestreo,
+        std::uint64_t semilla,
+        int replicas = 16,
+        unsigned num_hilos = 0
+    ) const;
+
+private:
+    // promedio de f sobre n puntos de la réplica r
+    double promedioReplica(const Funcion& f, long long n, Muestreo muestreo, std::uint64_t semilla, int r) const;
+};
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+
+// Philox4x32-10 (Salmon, Moraes, Dror y Shaw, "Parallel random numbers: as easy as
+// 1, 2, 3", SC 2011). Es un generador "por contador": cada llamada es una función pura
+// de (contador, clave) -> 4 enteros de 32 bits, sin estado. Para la simulación de
+// ensambles se usa clave = semilla y contador = (partícula, paso, bloque), así cada
+// partícula tiene su propia secuencia, los hilos no comparten nada y el resultado no
+// depende de cómo se repartan las partículas.
+struct Philox4x32
+{
+    std::uint32_t v[4];
+
+    static Philox4x32 generar(std::uint32_t c0, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                              std::uint32_t k0, std::uint32_t k1)
+    {
+        const std::uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+        const std::uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+        for (int r = 0; r < 10; ++r)
+        {
+            const std::uint64_t p0 = std::uint64_t(M0) * c0;
+            const std::uint64_t p1 = std::uint64_t(M1) * c2;
+            const std::uint32_t n0 = std::uint32_t(p1 >> 32) ^ c1 ^ k0;
+            const std::uint32_t n2 = std::uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c1 = std::uint32_t(p1);
+            c3 = std::uint32_t(p0);
+            c0 = n0;
+            c2 = n2;
+            k0 += W0;
+            k1 += W1;
+        }
+        return {{c0, c1, c2, c3}};
+    }
+};
+
+// Entero de 32 bits -> uniforme en (0, 1) (nunca 0, así log(u) es finito).
+inline double uniforme_abierto(std::uint32_t x)
+{
+    return (double(x) + 0.5) * (1.0 / 4294967296.0);
+}
+
+// Dos enteros de 32 bits -> uniforme en (0, 1) con los 53 bits de la mantisa.
+inline double uniforme_abierto_53(std::uint32_t alto, std::uint32_t bajo)
+{
+    const std::uint64_t x = ((std::uint64_t(alto) << 32) | bajo) >> 11;
+    return (double(x) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// log(u) para u > 0 normal (no subnormal), sin ramas para que el ciclo que la usa se
+// vectorice: u = m 2^e con m en [sqrt(1/2), sqrt(2)) y log(m) = 2 atanh(s), s = (m-1)/(m+1),
+// con la serie de atanh hasta s^21 (|s| <= 0.172, error relativo < 1e-16).
+inline double log_vectorizable(double u)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &u, sizeof(bits));
+    // se resta la mantisa de sqrt(1/2) para que m quede en [sqrt(1/2), sqrt(2))
+    const std::uint64_t desplazada = bits - 0x3FE6A09E667F3BCDull;
+    const std::int64_t e = std::int64_t(desplazada) >> 52;
+    const std::uint64_t bits_m = bits - (std::uint64_t(e) << 52);
+    double m;
+    std::memcpy(&m, &bits_m, sizeof(m));
+
+    const double s = (m - 1.0) / (m + 1.0);
+    const double s2 = s * s;
+    double p = 1.0 / 21.0;
+    p = p * s2 + 1.0 / 19.0;
+    p = p * s2 + 1.0 / 17.0;
+    p = p * s2 + 1.0 / 15.0;
+    p = p * s2 + 1.0 / 13.0;
+    p = p * s2 + 1.0 / 11.0;
+    p = p * s2 + 1.0 / 9.0;
+    p = p * s2 + 1.0 / 7.0;
+    p = p * s2 + 1.0 / 5.0;
+    p = p * s2 + 1.0 / 3.0;
+    p = p * s2 + 1.0;
+    return double(e) * 0.69314718055994530942 + 2.0 * s * p;
+}
+
+// sin(2 pi u) y cos(2 pi u) para u en [0, 1], sin ramas: se reduce al cuadrante
+// q = round(4u) y x = 2 pi (u - q/4) en [-pi/4, pi/4], donde bastan polinomios de Taylor
+// de grado 15/16.
+inline void sincos_2pi_vectorizable(double u, double& seno, double& coseno)
+{
+    const double q = std::floor(4.0 * u + 0.5);
+    const double x = 6.283185307179586 * (u - 0.25 * q);
+    const double x2 = x * x;
+    double sp = -1.0 / 1307674368000.0;       // -1/15!
+    sp = sp * x2 + 1.0 / 6227020800.0;        //  1/13!
+    sp = sp * x2 - 1.0 / 39916800.0;          // -1/11!
+    sp = sp * x2 + 1.0 / 362880.0;
+    sp = sp * x2 - 1.0 / 5040.0;
+    sp = sp * x2 + 1.0 / 120.0;
+    sp = sp * x2 - 1.0 / 6.0;
+    const double s = x + x * x2 * sp;
+    double cp = 1.0 / 20922789888000.0;       //  1/16!
+    cp = cp * x2 - 1.0 / 87178291200.0;       // -1/14!
+    cp = cp * x2 + 1.0 / 479001600.0;
+    cp = cp * x2 - 1.0 / 3628800.0;
+    cp = cp * x2 + 1.0 / 40320.0;
+    cp = cp * x2 - 1.0 / 720.0;
+    cp = cp * x2 + 1.0 / 24.0;
+    cp = cp * x2 - 0.5;
+    const double c = 1.0 + x2 * cp;
+
+    // rotacion por q cuartos de vuelta
+    const int cuadrante = int(q) & 3;
+    seno = (cuadrante == 0) ? s : (cuadrante == 1) ? c : (cuadrante == 2) ? -s : -c;
+    coseno = (cuadrante == 0) ? c : (cuadrante == 1) ? -s : (cuadrante == 2) ? -c : s;
+}
+
+// Box-Muller en el lugar: a[i], b[i] uniformes en (0, 1) -> dos normales independientes
+// de media 0 y desviacion sigma.
+inline void box_muller(double* a, double* b, std::size_t n, double sigma)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double r = sigma * std::sqrt(-2.0 * log_vectorizable(a[i]));
+        double seno, coseno;
+        sincos_2pi_vectorizable(b[i], seno, coseno);
+        a[i] = r * coseno;
+        b[i] = r * seno;
+    }
+}
+
+// Flujo de números aleatorios identificado por (semilla, flujo): la clave de Philox es la
+// semilla y el contador es (bloque, flujo), con bloque de 64 bits que avanza en uno por
+// cada 4 enteros generados. Dos flujos distintos nunca comparten un contador, así que
+// para repartir una simulación se le da a cada trozo de trabajo (no a cada hilo) su
+// propio número de flujo y el resultado no depende del número de hilos.
+//
+// - uniformes/normales llenan arreglos completos; sus ciclos no tienen ramas ni llamadas,
+//   así el compilador los vectoriza. Cada llamada empieza en un bloque nuevo.
+// - operator() da enteros de 32 bits (UniformRandomBitGenerator), para usarlo también
+//   con las distribuciones de <random>.
+class PhiloxStream
+{
+public:
+    using result_type = std::uint32_t;
+
+private:
+    std::uint32_t k0_, k1_;  // semilla
+    std::uint32_t f0_, f1_;  // flujo
+    std::uint64_t bloque_;   // siguiente bloque de 4 enteros
+    Philox4x32 resto_;       // ultimo bloque de las llamadas escalares
+    int usados_;             // enteros de resto_ ya entregados
+    double normal_guardada_;
+    bool hay_normal_;
+
+    Philox4x32 generarBloque(std::uint64_t b) const
+    {
+        return Philox4x32::generar(std::uint32_t(b), std::uint32_t(b >> 32), f0_, f1_, k0_, k1_);
+    }
+
+public:
+    explicit PhiloxStream(std::uint64_t semilla, std::uint64_t flujo = 0)
+        : k0_(std::uint32_t(semilla)), k1_(std::uint32_t(semilla >> 32)),
+          f0_(std::uint32_t(flujo)), f1_(std::uint32_t(flujo >> 32)),
+          bloque_(0), resto_(), usados_(4), normal_guardada_(0.0), hay_normal_(false)
+    {
+    }
+
+    static constexpr result_type min() { return 0u; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    result_type operator()()
+    {
+        if (usados_ == 4)
+        {
+            resto_ = generarBloque(bloque_++);
+            usados_ = 0;
+        }
+        return resto_.v[usados_++];
+    }
+
+    // Salta 'bloques' bloques de 4 enteros sin generarlos.
+    void saltar(std::uint64_t bloques)
+    {
+        bloque_ += bloques;
+        usados_ = 4;
+        hay_normal_ = false;
+    }
+    std::uint64_t bloque() const { return bloque_; }
+
+    // out[i] uniforme en (0, 1) con 53 bits, dos por bloque. Los bloques se generan de a
+    // 'trozo' en arreglos por palabra, para que las 10 rondas se vectoricen entre bloques.
+    void uniformes(double* out, std::size_t n)
+    {
+        const std::size_t trozo = 64;
+        std::uint32_t w[4][trozo];
+        const std::size_t bloques = (n + 1) / 2;
+        for (std::size_t j0 = 0; j0 < bloques; j0 += trozo)
+        {
+            const std::size_t m = (bloques - j0 < trozo) ? bloques - j0 : trozo;
+            const std::uint64_t b0 = bloque_ + j0;
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                const std::uint64_t b = b0 + j;
+                const Philox4x32 r = Philox4x32::generar(std::uint32_t(b), std::uint32_t(b >> 32), f0_, f1_, k0_, k1_);
+                w[0][j] = r.v[0];
+                w[1][j] = r.v[1];
+                w[2][j] = r.v[2];
+                w[3][j] = r.v[3];
+            }
+            double* o = out + 2 * j0;
+            const std::size_t pares = (2 * (j0 + m) <= n) ? m : m - 1;
+            for (std::size_t j = 0; j < pares; ++j)
+            {
+                o[2 * j] = uniforme_abierto_53(w[0][j], w[1][j]);
+                o[2 * j + 1] = uniforme_abierto_53(w[2][j], w[3][j]);
+            }
+            if (pares < m) o[2 * pares] = uniforme_abierto_53(w[0][pares], w[1][pares]);
+        }
+        bloque_ += bloques;
+        usados_ = 4;
+    }
+
+    // out[i] uniforme en (a, b).
+    void uniformes(double* out, std::size_t n, double a, double b)
+    {
+        uniformes(out, n);
+        const double ancho = b - a;
+        for (std::size_t i = 0; i < n; ++i) out[i] = a + ancho * out[i];
+    }
+
+    // out[i] normal de media 'media' y desviacion 'sigma' (Box-Muller entre la primera
+    // y la segunda mitad del arreglo).
+    void normales(double* out, std::size_t n, double media = 0.0, double sigma = 1.0)
+    {
+        const std::size_t mitad = n / 2;
+        uniformes(out, 2 * mitad);
+        box_muller(out, out + mitad, mitad, sigma);
+        if (n % 2 == 1)
+        {
+            double par[2];
+            uniformes(par, 2);
+            box_muller(par, par + 1, 1, sigma);
+            out[n - 1] = par[0];
+        }
+        if (media != 0.0)
+            for (std::size_t i = 0; i < n; ++i) out[i] += media;
+    }
+
+    // versiones escalares (mas lentas; para pocos valores)
+    double uniforme()
+    {
+        const std::uint32_t alto = (*this)();
+        return uniforme_abierto_53(alto, (*this)());
+    }
+    double uniforme(double a, double b) { return a + (b - a) * uniforme(); }
+    double normal(double media = 0.0, double sigma = 1.0)
+    {
+        if (hay_normal_)
+        {
+            hay_normal_ = false;
+            return media + sigma * normal_guardada_;
+        }
+        double u = uniforme(), v = uniforme();
+        box_muller(&u, &v, 1, 1.0);
+        normal_guardada_ = v;
+        hay_normal_ = true;
+        return media + sigma * u;
+    }
+};
+
+#endif
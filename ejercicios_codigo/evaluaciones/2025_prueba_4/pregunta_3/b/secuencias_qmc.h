@@ -0,0 +1,154 @@
+#ifndef SECUENCIAS_QMC_H
+#define SECUENCIAS_QMC_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+// Secuencias de baja discrepancia en [0, 1)^d para Monte Carlo cuasi aleatorio (QMC).
+// Sus puntos cubren el cubo de forma mucho más pareja que los pseudoaleatorios y, para
+// integrandos suaves, el error baja casi como 1/N en vez de 1/sqrt(N).
+
+// Halton: la coordenada j del punto i es el inverso radical de i en la base p_j (el
+// j-ésimo primo). Sirve para cualquier dimensión, pero con primos grandes las primeras
+// coordenadas quedan correlacionadas; conviene para d pequeño (hasta ~10).
+class Halton
+{
+private:
+    std::vector<unsigned> bases_;
+    std::uint64_t indice_;
+
+public:
+    explicit Halton(std::size_t dimension) : indice_(1) // el punto 0 es el origen; se salta
+    {
+        for (unsigned p = 2; bases_.size() < dimension; ++p)
+        {
+            bool primo = true;
+            for (unsigned q : bases_)
+            {
+                if (q * q > p) break;
+                if (p % q == 0) { primo = false; break; }
+            }
+            if (primo) bases_.push_back(p);
+        }
+    }
+
+    std::size_t dimension() const { return bases_.size(); }
+
+    // x[0..d) = siguiente punto de la secuencia
+    void siguiente(double* x)
+    {
+        for (std::size_t j = 0; j < bases_.size(); ++j)
+        {
+            const unsigned p = bases_[j];
+            const double inv_p = 1.0 / p;
+            double f = inv_p, r = 0.0;
+            for (std::uint64_t i = indice_; i > 0; i /= p)
+            {
+                r += f * double(i % p);
+                f *= inv_p;
+            }
+            x[j] = r;
+        }
+        ++indice_;
+    }
+};
+
+// Sobol con los números de dirección de Joe y Kuo (2008, new-joe-kuo-6.21201) y
+// enteros de 32 bits: el punto n+1 se obtiene del n con un XOR por coordenada (código
+// de Gray), así que generar un punto cuesta O(d). Da hasta 2^32 puntos en hasta
+// max_dimension dimensiones. Los mejores resultados se obtienen con N potencia de 2.
+class Sobol
+{
+public:
+    static constexpr std::size_t max_dimension = 21;
+
+private:
+    std::size_t d_;
+    std::vector<std::uint32_t> v_;   // v_[32 j + k]: número de dirección k de la coordenada j
+    std::vector<std::uint32_t> x_;   // punto actual como enteros
+    std::uint64_t indice_;
+
+    // grado s, coeficientes interiores a del polinomio primitivo y m_1..m_s (dimensiones 2..21)
+    struct Direccion { unsigned s, a; unsigned m[7]; };
+
+    static const Direccion* tabla()
+    {
+        static const Direccion t[max_dimension - 1] = {
+            {1, 0, {1}},
+            {2, 1, {1, 3}},
+            {3, 1, {1, 3, 1}},
+            {3, 2, {1, 1, 1}},
+            {4, 1, {1, 1, 3, 3}},
+            {4, 4, {1, 3, 5, 13}},
+            {5, 2, {1, 1, 5, 5, 17}},
+            {5, 4, {1, 1, 5, 5, 5}},
+            {5, 7, {1, 1, 7, 11, 19}},
+            {5, 11, {1, 1, 5, 1, 1}},
+            {5, 13, {1, 1, 1, 3, 11}},
+            {5, 14, {1, 3, 5, 5, 31}},
+            {6, 1, {1, 3, 3, 9, 7, 49}},
+            {6, 13, {1, 1, 1, 15, 21, 21}},
+            {6, 16, {1, 3, 1, 13, 27, 49}},
+            {6, 19, {1, 1, 1, 15, 7, 5}},
+            {6, 22, {1, 3, 1, 15, 13, 25}},
+            {6, 25, {1, 1, 5, 5, 19, 61}},
+            {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+            {7, 4, {1, 3, 7, 13, 13, 15, 69}},
+        };
+        return t;
+    }
+
+public:
+    explicit Sobol(std::size_t dimension)
+        : d_(dimension), v_(32 * dimension), x_(dimension, 0u), indice_(0)
+    {
+        if (dimension == 0 || dimension > max_dimension)
+            throw std::invalid_argument("Sobol: la dimension debe estar entre 1 y 21.");
+
+        // primera coordenada: van der Corput en base 2
+        for (unsigned k = 0; k < 32; ++k) v_[k] = 1u << (31 - k);
+        for (std::size_t j = 1; j < d_; ++j)
+        {
+            const Direccion& dir = tabla()[j - 1];
+            std::uint32_t* v = &v_[32 * j];
+            for (unsigned k = 0; k < dir.s; ++k) v[k] = std::uint32_t(dir.m[k]) << (31 - k);
+            for (unsigned k = dir.s; k < 32; ++k)
+            {
+                std::uint32_t nuevo = v[k - dir.s] ^ (v[k - dir.s] >> dir.s);
+                for (unsigned i = 1; i < dir.s; ++i)
+                    if ((dir.a >> (dir.s - 1 - i)) & 1u) nuevo ^= v[k - i];
+                v[k] = nuevo;
+            }
+        }
+    }
+
+    std::size_t dimension() const { return d_; }
+
+    // x[0..d) = siguiente punto como enteros de 32 bits (punto / 2^32); el primero es el origen
+    void siguienteEntero(std::uint32_t* x)
+    {
+        for (std::size_t j = 0; j < d_; ++j) x[j] = x_[j];
+        avanzar();
+    }
+
+    void siguiente(double* x)
+    {
+        for (std::size_t j = 0; j < d_; ++j) x[j] = double(x_[j]) * (1.0 / 4294967296.0);
+        avanzar();
+    }
+
+private:
+    void avanzar()
+    {
+        // el bit que cambia es el menos significativo en cero del indice
+        unsigned c = 0;
+        for (std::uint64_t n = indice_; n & 1u; n >>= 1) ++c;
+        if (c < 32)
+            for (std::size_t j = 0; j < d_; ++j) x_[j] ^= v_[32 * j + c];
+        ++indice_;
+    }
+};
+
+#endif
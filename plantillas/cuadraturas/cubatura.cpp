@@ -0,0 +1,250 @@
+#include "cubatura.h"
+#include "reglas_gauss.h"
+#include <cmath>
+#include <map>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    const long long bloque = 256;
+
+    // suma por pares: el orden de las sumas es fijo y el error de redondeo crece como log n
+    double sumarPorPares(const double* v, std::size_t n)
+    {
+        if (n <= 8)
+        {
+            double s = 0.0;
+            for (std::size_t i = 0; i < n; ++i) s += v[i];
+            return s;
+        }
+        const std::size_t mitad = n / 2;
+        return sumarPorPares(v, mitad) + sumarPorPares(v + mitad, n - mitad);
+    }
+
+    // sum_k w_k f(x_k) sobre 'total' nodos en [-1, 1]^d. llenar(k0, m, t, w) escribe los
+    // nodos k0..k0+m-1 en t (m filas de d) y sus pesos en w; cada hilo los lleva a
+    // [a, b] y evalúa f un bloque a la vez.
+    template <class Llenar>
+    double sumarEnParalelo(const FuncionLoteND& f, const std::vector<double>& a, const std::vector<double>& b,
+                           long long total, Llenar&& llenar, unsigned num_hilos)
+    {
+        const std::size_t d = a.size();
+        std::vector<double> centro(d), semi(d);
+        double jacobiano = 1.0;
+        for (std::size_t j = 0; j < d; ++j)
+        {
+            centro[j] = 0.5 * (a[j] + b[j]);
+            semi[j] = 0.5 * (b[j] - a[j]);
+            jacobiano *= semi[j];
+        }
+
+        const long long num_bloques = (total + bloque - 1) / bloque;
+        std::vector<double> parciales(std::size_t(num_bloques), 0.0);
+
+        std::atomic<long long> siguiente{0};
+        auto trabajador = [&]
+        {
+            std::vector<double> x(std::size_t(bloque) * d), w(bloque), fx(bloque);
+            for (long long k = siguiente.fetch_add(1); k < num_bloques; k = siguiente.fetch_add(1))
+            {
+                const long long k0 = k * bloque;
+                const std::size_t m = std::size_t(std::min<long long>(bloque, total - k0));
+                llenar(k0, m, x.data(), w.data());
+                for (std::size_t i = 0; i < m; ++i)
+                    for (std::size_t j = 0; j < d; ++j) x[i * d + j] = centro[j] + semi[j] * x[i * d + j];
+                f(x.data(), fx.data(), m);
+                double s = 0.0;
+                for (std::size_t i = 0; i < m; ++i) s += w[i] * fx[i];
+                parciales[std::size_t(k)] = s;
+            }
+        };
+        long long hilos = num_hilos;
+        if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+        hilos = std::max(1LL, std::min(hilos, num_bloques));
+        std::vector<std::thread> auxiliares;
+        for (long long t = 1; t < hilos; ++t) auxiliares.emplace_back(trabajador);
+        trabajador();
+        for (std::thread& h : auxiliares) h.join();
+
+        return jacobiano * sumarPorPares(parciales.data(), parciales.size());
+    }
+
+    // n^d como long long, o -1 si pasa de 'limite'
+    long long potencia(long long n, std::size_t d, long long limite)
+    {
+        long long r = 1;
+        for (std::size_t j = 0; j < d; ++j)
+        {
+            if (r > limite / n) return -1;
+            r *= n;
+        }
+        return r;
+    }
+
+    const long long max_nodos_tensorial = 1LL << 40;
+
+    // Regla tensorial de n puntos por eje; los nodos se generan al vuelo con un
+    // contador en base n (el eje 0 es el dígito que cambia más rápido).
+    double integrarTensorial(const FuncionLoteND& f, const std::vector<double>& a, const std::vector<double>& b,
+                             int n, long long total, unsigned num_hilos)
+    {
+        const std::size_t d = a.size();
+        const ReglaGauss& regla = reglaGauss(FamiliaGauss::LEGENDRE, n);
+        auto llenar = [&](long long k0, std::size_t m, double* t, double* w)
+        {
+            std::vector<int> digito(d);
+            long long resto = k0;
+            for (std::size_t j = 0; j < d; ++j)
+            {
+                digito[j] = int(resto % n);
+                resto /= n;
+            }
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                double peso = 1.0;
+                for (std::size_t j = 0; j < d; ++j)
+                {
+                    t[i * d + j] = regla.nodos[digito[j]];
+                    peso *= regla.pesos[digito[j]];
+                }
+                w[i] = peso;
+                for (std::size_t j = 0; j < d && ++digito[j] == n; ++j) digito[j] = 0;
+            }
+        };
+        return sumarEnParalelo(f, a, b, total, llenar, num_hilos);
+    }
+
+    double integrarSmolyak(const FuncionLoteND& f, const std::vector<double>& a, const std::vector<double>& b,
+                           int nivel, long long& nodos, unsigned num_hilos)
+    {
+        const std::size_t d = a.size();
+        std::vector<double> t, w;
+        CubaturaND::rejillaSmolyak(d, nivel, t, w);
+        nodos = (long long)w.size();
+        auto llenar = [&](long long k0, std::size_t m, double* x, double* peso)
+        {
+            std::copy(t.begin() + k0 * d, t.begin() + (k0 + (long long)m) * d, x);
+            std::copy(w.begin() + k0, w.begin() + k0 + (long long)m, peso);
+        };
+        return sumarEnParalelo(f, a, b, nodos, llenar, num_hilos);
+    }
+}
+
+CubaturaND::CubaturaND(const std::vector<double>& a, const std::vector<double>& b)
+    : a_(a), b_(b)
+{
+    if (a_.empty() || a_.size() != b_.size())
+        throw std::invalid_argument("CubaturaND: a y b deben tener la misma dimension (al menos 1).");
+    for (std::size_t j = 0; j < a_.size(); ++j)
+        if (a_[j] >= b_[j])
+            throw std::invalid_argument("CubaturaND: se necesita a[j] < b[j] en cada dimension.");
+}
+
+void CubaturaND::rejillaSmolyak(std::size_t d, int nivel, std::vector<double>& nodos, std::vector<double>& pesos)
+{
+    if (d < 1 || nivel < 1) throw std::invalid_argument("CubaturaND: se necesita d >= 1 y nivel >= 1.");
+    const int q = nivel + int(d) - 1;
+
+    // C(d - 1, k)
+    std::vector<double> binomial(d, 1.0);
+    for (std::size_t k = 1; k < d; ++k) binomial[k] = binomial[k - 1] * double(d - k) / double(k);
+
+    // nodo -> peso acumulado; los nodos de reglas distintas se comparan por valor (el 0
+    // de las reglas impares es exactamente 0.0 y se comparte)
+    std::map<std::vector<double>, double> acumulado;
+    std::vector<int> l(d, 1);
+    std::vector<const ReglaGauss*> reglas(d);
+    std::vector<int> indice(d);
+    std::vector<double> punto(d);
+
+    // recorre todos los multi-índices l >= 1 con |l| <= q
+    int suma = int(d);
+    while (true)
+    {
+        if (suma >= nivel)
+        {
+            const int k = q - suma;
+            const double coeficiente = ((k % 2) ? -1.0 : 1.0) * binomial[std::size_t(k)];
+            for (std::size_t j = 0; j < d; ++j) reglas[j] = &reglaGauss(FamiliaGauss::LEGENDRE, 2 * l[j] - 1);
+            std::fill(indice.begin(), indice.end(), 0);
+            while (true)
+            {
+                double peso = coeficiente;
+                for (std::size_t j = 0; j < d; ++j)
+                {
+                    punto[j] = reglas[j]->nodos[std::size_t(indice[j])];
+                    peso *= reglas[j]->pesos[std::size_t(indice[j])];
+                }
+                acumulado[punto] += peso;
+                std::size_t j = 0;
+                while (j < d && ++indice[j] == 2 * l[j] - 1) indice[j++] = 0;
+                if (j == d) break;
+            }
+        }
+        // siguiente multi-índice: sube l[0]; si |l| pasa de q, vuelve a 1 y sube el próximo eje
+        std::size_t j = 0;
+        while (j < d)
+        {
+            ++l[j];
+            ++suma;
+            if (suma <= q) break;
+            suma -= l[j] - 1;
+            l[j] = 1;
+            ++j;
+        }
+        if (j == d) break;
+    }
+
+    nodos.clear();
+    pesos.clear();
+    nodos.reserve(acumulado.size() * d);
+    pesos.reserve(acumulado.size());
+    for (const auto& par : acumulado)
+    {
+        // los pesos que se cancelan del todo no aportan
+        if (par.second == 0.0) continue;
+        nodos.insert(nodos.end(), par.first.begin(), par.first.end());
+        pesos.push_back(par.second);
+    }
+}
+
+ResultadoCubatura CubaturaND::productoTensorial(const FuncionLoteND& f, int n_puntos, unsigned num_hilos) const
+{
+    if (n_puntos < 1) throw std::invalid_argument("CubaturaND: se necesita n_puntos >= 1.");
+    const long long total = potencia(n_puntos, dimension(), max_nodos_tensorial);
+    if (total < 0) throw std::invalid_argument("CubaturaND: demasiados nodos para el producto tensorial, usar smolyak.");
+
+    ResultadoCubatura resultado;
+    resultado.valor = integrarTensorial(f, a_, b_, n_puntos, total, num_hilos);
+    resultado.nodos = total;
+    resultado.evaluaciones = total;
+    resultado.error = std::numeric_limits<double>::infinity();
+    if (n_puntos > 1)
+    {
+        const long long anterior = potencia(n_puntos - 1, dimension(), max_nodos_tensorial);
+        resultado.error = std::fabs(resultado.valor - integrarTensorial(f, a_, b_, n_puntos - 1, anterior, num_hilos));
+        resultado.evaluaciones += anterior;
+    }
+    return resultado;
+}
+
+ResultadoCubatura CubaturaND::smolyak(const FuncionLoteND& f, int nivel, unsigned num_hilos) const
+{
+    if (nivel < 1) throw std::invalid_argument("CubaturaND: se necesita nivel >= 1.");
+
+    ResultadoCubatura resultado;
+    resultado.valor = integrarSmolyak(f, a_, b_, nivel, resultado.nodos, num_hilos);
+    resultado.evaluaciones = resultado.nodos;
+    resultado.error = std::numeric_limits<double>::infinity();
+    if (nivel > 1)
+    {
+        long long anterior = 0;
+        resultado.error = std::fabs(resultado.valor - integrarSmolyak(f, a_, b_, nivel - 1, anterior, num_hilos));
+        resultado.evaluaciones += anterior;
+    }
+    return resultado;
+}
@@ -3,6 +3,39 @@
 
 #include <iostream>   // Para std::cerr (salida básica de errores)
 #include <functional> // ¡MUY IMPORTANTE! Para std::function
+#include <cstddef>    // Para std::size_t
+
+// Integrando por lotes: out[i] = f(x[i]) para i = 0..n-1. Las reglas generan sus nodos en
+// bloques y llaman a f una vez por bloque, así la llamada indirecta se paga por bloque y
+// no por punto, y el cuerpo de f puede ser un ciclo que el compilador vectoriza.
+using FuncionLote = std::function<void(const double* x, double* out, std::size_t n)>;
+
+// Par de reglas de Gauss-Kronrod: la de Kronrod (15 o 21 puntos) reutiliza los nodos de
+// la de Gauss (7 o 10) y la diferencia entre ambas estima el error sin evaluar más.
+enum class ReglaGaussKronrod { G7K15, G10K21 };
+
+// Opciones de GaussKronrod. Se detiene cuando error <= max(tol_abs, tol_rel * |valor|)
+// o cuando se alcanza max_evaluaciones.
+struct OpcionesGaussKronrod
+{
+    double tol_abs = 1e-10;
+    double tol_rel = 1e-10;
+    long long max_evaluaciones = 100000;
+    ReglaGaussKronrod regla = ReglaGaussKronrod::G7K15;
+    // Cambio de variable x = a + (b - a)(3t² - 2t³): su jacobiano 6t(1 - t) se anula en los
+    // extremos y suaviza singularidades integrables ahí (como 1/sqrt(x - a) o log(x - a)).
+    // Solo se aplica con límites finitos.
+    bool suavizar_extremos = false;
+};
+
+struct ResultadoCuadratura
+{
+    double valor = 0.0;
+    double error = 0.0;        // estimación del error absoluto
+    long long evaluaciones = 0;
+    int subintervalos = 0;
+    bool convergio = false;    // false si se agotó el presupuesto antes de la tolerancia
+};
 
 // Clase para integración numérica
 class NumericalIntegrator
@@ -32,14 +65,38 @@ public:
     double Simpson(std::function<double(double)> f, int n_subintervals);
     
     // Método de Romberg
-    // n_iterations: Número de niveles de refinamiento.
-    double Romberg(std::function<double(double)> f, int n_iterations);
+    // n_iterations: Número máximo de niveles de refinamiento. Cada nivel evalúa solo los
+    // puntos medios nuevos (el nivel k cuesta 2^(k-1) evaluaciones) y se guardan dos filas
+    // de la tabla. Si tolerancia > 0, se detiene cuando dos elementos consecutivos de la
+    // diagonal difieren en menos de tolerancia * |valor|.
+    double Romberg(std::function<double(double)> f, int n_iterations, double tolerancia = 0.0);
     
-    // Cuadratura de Gauss-Legendre (implementación fija a 3 puntos)
+    // Cuadratura de Gauss-Legendre de 3 puntos
     double GaussLegendre(std::function<double(double)> f);
 
+    // Gauss-Legendre de n_puntos (ver reglas_gauss.h): exacta para polinomios de grado 2n - 1
+    double GaussLegendre(std::function<double(double)> f, int n_puntos);
+
     // Integración por Montecarlo
     double Montecarlo(std::function<double(double)> f, int n_samples);
+
+    // Gauss-Kronrod adaptativo con control global del error: mantiene una cola de
+    // prioridad de subintervalos ordenada por su error estimado y biseca siempre el peor.
+    // Los límites pueden ser infinitos (std::numeric_limits<double>::infinity()): se
+    // integra en t con x = a + t/(1 - t), x = b - t/(1 - t) o x = t/(1 - t²).
+    ResultadoCuadratura GaussKronrod(std::function<double(double)> f,
+                                     const OpcionesGaussKronrod& opciones = OpcionesGaussKronrod());
+
+    // Las mismas reglas con el integrando por lotes (ver FuncionLote); dan los mismos
+    // resultados que las versiones escalares.
+    double Trapecio(FuncionLote f, int n_subintervals);
+    double Simpson(FuncionLote f, int n_subintervals);
+    double Romberg(FuncionLote f, int n_iterations, double tolerancia = 0.0);
+    double GaussLegendre(FuncionLote f);
+    double GaussLegendre(FuncionLote f, int n_puntos);
+    double Montecarlo(FuncionLote f, int n_samples);
+    ResultadoCuadratura GaussKronrod(FuncionLote f,
+                                     const OpcionesGaussKronrod& opciones = OpcionesGaussKronrod());
 };
 
 #endif // NUMERICAL_INTEGRATION_H
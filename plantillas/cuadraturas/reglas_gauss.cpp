@@ -0,0 +1,296 @@
+#include "reglas_gauss.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <limits>
+
+namespace
+{
+    const double pi = 3.14159265358979323846;
+    const int max_iteraciones_newton = 100;
+
+    // Las recurrencias de Hermite y Laguerre sin el peso crecen como e^{x²/2} y e^{x/2}:
+    // con n grande se desbordan cerca de los nodos mayores. Cuando pasan de 2^escalon se
+    // multiplican por 2^-escalon y se lleva la cuenta en un exponente aparte.
+    const int escalon = 512;
+    const double umbral_escala = std::ldexp(1.0, escalon);
+
+    // Newton desde x hasta que el paso sea del orden del redondeo de x, o hasta que un paso
+    // ya muy chico deje de achicarse (el ruido de redondeo de p no deja bajar más). Devuelve
+    // false si no converge en max_iteraciones_newton pasos o el paso deja de ser finito.
+    template <class Evaluar>
+    bool newton(double& x, Evaluar&& evaluar)
+    {
+        double paso_anterior = std::numeric_limits<double>::infinity();
+        for (int it = 0; it < max_iteraciones_newton; ++it)
+        {
+            double p, dp;
+            evaluar(x, p, dp);
+            const double dx = p / dp;
+            if (!std::isfinite(dx)) return false;
+            x -= dx;
+            const double escala = std::max(1.0, std::fabs(x));
+            const double paso = std::fabs(dx);
+            if (paso <= 1e-15 * escala) return true;
+            if (paso <= 1e-12 * escala && paso >= 0.5 * paso_anterior) return true;
+            paso_anterior = paso;
+        }
+        return false;
+    }
+
+    double raiz(const char* familia, double x, int n, const std::function<void(double, double&, double&)>& evaluar)
+    {
+        if (!newton(x, evaluar))
+            throw std::runtime_error(std::string("reglaGauss: Newton no convergio para ") + familia +
+                                     " de " + std::to_string(n) + " puntos.");
+        return x;
+    }
+
+    // Las raices deben quedar estrictamente crecientes y finitas; si no, alguna aproximacion
+    // inicial llevo a Newton a una raiz ya encontrada y la regla esta mal.
+    void verificarOrden(const char* familia, int n, const ReglaGauss& regla)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const bool ok = std::isfinite(regla.nodos[i]) && std::isfinite(regla.pesos[i]) &&
+                            (i == 0 || regla.nodos[i - 1] < regla.nodos[i]);
+            if (!ok)
+                throw std::runtime_error(std::string("reglaGauss: nodos repetidos o desordenados para ") +
+                                         familia + " de " + std::to_string(n) + " puntos.");
+        }
+    }
+
+    // t en [0, pi] con t - sin t = c, 0 <= c <= pi (biseccion: t - sin t es creciente)
+    double resolverKepler(double c)
+    {
+        double a = 0.0, b = pi;
+        for (int it = 0; it < 60; ++it)
+        {
+            const double t = 0.5 * (a + b);
+            if (t - std::sin(t) < c) a = t;
+            else b = t;
+        }
+        return 0.5 * (a + b);
+    }
+
+    // P_n(x) y P_n'(x) con la recurrencia j P_j = (2j - 1) x P_{j-1} - (j - 1) P_{j-2}
+    void legendre(int n, double x, double& p, double& dp, double& p_anterior)
+    {
+        double p0 = 1.0, p1 = x;
+        for (int j = 2; j <= n; ++j)
+        {
+            const double p2 = ((2.0 * j - 1.0) * x * p1 - (j - 1.0) * p0) / j;
+            p0 = p1;
+            p1 = p2;
+        }
+        p = (n == 0) ? 1.0 : p1;
+        p_anterior = (n == 0) ? 0.0 : p0;
+        dp = n * (x * p - p_anterior) / (x * x - 1.0);
+    }
+
+    ReglaGauss calcularLegendre(int n)
+    {
+        ReglaGauss regla;
+        regla.nodos.resize(n);
+        regla.pesos.resize(n);
+        if (n <= max_orden_tabla_legendre)
+        {
+            // desde la tabla: las filas van del nodo mayor al menor
+            const int inicio = inicio_tabla_legendre[n - 1];
+            for (int i = 0; i < (n + 1) / 2; ++i)
+            {
+                const double x = tabla_legendre[inicio + i][0], w = tabla_legendre[inicio + i][1];
+                regla.nodos[i] = -x;
+                regla.pesos[i] = w;
+                regla.nodos[n - 1 - i] = x;
+                regla.pesos[n - 1 - i] = w;
+            }
+            return regla;
+        }
+        for (int i = 0; i < (n + 1) / 2; ++i)
+        {
+            // aproximacion inicial de Tricomi para la raiz i (de mayor a menor)
+            double x = std::cos(pi * (i + 0.75) / (n + 0.5));
+            x = raiz("Legendre", x, n, [n](double z, double& p, double& dp) { double q; legendre(n, z, p, dp, q); });
+            double p, dp, q;
+            legendre(n, x, p, dp, q);
+            const double w = 2.0 / ((1.0 - x * x) * dp * dp);
+            if (n % 2 == 1 && i == n / 2) x = 0.0;
+            regla.nodos[i] = -x;
+            regla.pesos[i] = w;
+            regla.nodos[n - 1 - i] = x;
+            regla.pesos[n - 1 - i] = w;
+        }
+        verificarOrden("Legendre", n, regla);
+        return regla;
+    }
+
+    // Hermite ortonormales: h_j = x sqrt(2/j) h_{j-1} - sqrt((j-1)/j) h_{j-2}, h_0 = pi^{-1/4};
+    // h_n' = sqrt(2n) h_{n-1} y w = 2 / h_n'². Los valores verdaderos son p 2^escala y
+    // dp 2^escala.
+    void hermite(int n, double x, double& p, double& dp, int& escala)
+    {
+        double p0 = 0.0, p1 = 1.0 / std::pow(pi, 0.25);
+        escala = 0;
+        for (int j = 1; j <= n; ++j)
+        {
+            const double p2 = x * std::sqrt(2.0 / j) * p1 - std::sqrt((j - 1.0) / j) * p0;
+            p0 = p1;
+            p1 = p2;
+            if (std::fabs(p1) > umbral_escala)
+            {
+                p0 = std::ldexp(p0, -escalon);
+                p1 = std::ldexp(p1, -escalon);
+                escala += escalon;
+            }
+        }
+        p = p1;
+        dp = std::sqrt(2.0 * n) * p0;
+    }
+
+    // Aproximacion de Tricomi de la raiz positiva k (k = 1 la mayor) de H_n, con nu = 2n + 1:
+    // x = sqrt(nu) cos(t / 2) con t - sin t = pi (4k - 1) / nu. Queda a menos de 1/100 del
+    // espaciado entre raices para todo k y todo n, asi que Newton no salta a otra raiz.
+    double inicialHermite(int n, int k)
+    {
+        const double nu = 2.0 * n + 1.0;
+        const double t = resolverKepler(pi * (4.0 * k - 1.0) / nu);
+        return std::sqrt(nu) * std::cos(0.5 * t);
+    }
+
+    ReglaGauss calcularHermite(int n)
+    {
+        ReglaGauss regla;
+        regla.nodos.resize(n);
+        regla.pesos.resize(n);
+        for (int i = 0; i < (n + 1) / 2; ++i)
+        {
+            double x = (n % 2 == 1 && i == n / 2) ? 0.0 : inicialHermite(n, i + 1);
+            x = raiz("Hermite", x, n, [n](double z, double& p, double& dp) { int e; hermite(n, z, p, dp, e); });
+            double p, dp;
+            int escala;
+            hermite(n, x, p, dp, escala);
+            // w = 2 / (dp 2^escala)²; se anula por debajo del menor double para los nodos extremos
+            const double w = std::ldexp(2.0 / (dp * dp), -2 * escala);
+            if (n % 2 == 1 && i == n / 2) x = 0.0;
+            regla.nodos[i] = -x;
+            regla.pesos[i] = w;
+            regla.nodos[n - 1 - i] = x;
+            regla.pesos[n - 1 - i] = w;
+        }
+        verificarOrden("Hermite", n, regla);
+        return regla;
+    }
+
+    // L_n(x) con j L_j = (2j - 1 - x) L_{j-1} - (j - 1) L_{j-2}; x L_n' = n (L_n - L_{n-1}).
+    // Como en hermite, los valores verdaderos son p 2^escala y dp 2^escala.
+    void laguerre(int n, double x, double& p, double& dp, int& escala)
+    {
+        double p0 = 0.0, p1 = 1.0;
+        escala = 0;
+        for (int j = 1; j <= n; ++j)
+        {
+            const double p2 = ((2.0 * j - 1.0 - x) * p1 - (j - 1.0) * p0) / j;
+            p0 = p1;
+            p1 = p2;
+            if (std::fabs(p1) > umbral_escala)
+            {
+                p0 = std::ldexp(p0, -escalon);
+                p1 = std::ldexp(p1, -escalon);
+                escala += escalon;
+            }
+        }
+        p = p1;
+        dp = n * (p1 - p0) / x;
+    }
+
+    // Aproximacion de Tricomi de la raiz k (k = 1 la menor) de L_n, con nu = 4n + 2:
+    // x = nu cos²(t / 2) con t - sin t = pi (4n - 4k + 3) / nu. Como en Hermite, el error es
+    // menor que 1/100 del espaciado entre raices.
+    double inicialLaguerre(int n, int k)
+    {
+        const double nu = 4.0 * n + 2.0;
+        const double t = resolverKepler(pi * (4.0 * n - 4.0 * k + 3.0) / nu);
+        const double c = std::cos(0.5 * t);
+        return nu * c * c;
+    }
+
+    ReglaGauss calcularLaguerre(int n)
+    {
+        ReglaGauss regla;
+        regla.nodos.resize(n);
+        regla.pesos.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            double x = raiz("Laguerre", inicialLaguerre(n, i + 1), n,
+                            [n](double t, double& p, double& dp) { int e; laguerre(n, t, p, dp, e); });
+            double p, dp;
+            int escala;
+            laguerre(n, x, p, dp, escala);
+            regla.nodos[i] = x;
+            // w = x / ((n + 1)² L_{n+1}(x)²) = 1 / (x L_n'(x)²)
+            regla.pesos[i] = std::ldexp(1.0 / (x * dp * dp), -2 * escala);
+        }
+        verificarOrden("Laguerre", n, regla);
+        return regla;
+    }
+
+    ReglaGauss calcularChebyshev(int n)
+    {
+        ReglaGauss regla;
+        regla.nodos.resize(n);
+        regla.pesos.assign(n, pi / n);
+        for (int i = 0; i < n; ++i) regla.nodos[i] = -std::cos(pi * (2.0 * i + 1.0) / (2.0 * n));
+        if (n % 2 == 1) regla.nodos[n / 2] = 0.0;
+        return regla;
+    }
+}
+
+const ReglaGauss& reglaGauss(FamiliaGauss familia, int n)
+{
+    if (n < 1) throw std::invalid_argument("reglaGauss: se necesita al menos un punto.");
+
+    // Gauss-Legendre de la tabla: se arma una sola vez (la inicialización de un static
+    // local es segura entre hilos) y después se entrega sin bloquear
+    if (familia == FamiliaGauss::LEGENDRE && n <= max_orden_tabla_legendre)
+    {
+        static const std::vector<ReglaGauss> tabladas = []
+        {
+            std::vector<ReglaGauss> reglas(max_orden_tabla_legendre + 1);
+            for (int k = 1; k <= max_orden_tabla_legendre; ++k) reglas[k] = calcularLegendre(k);
+            return reglas;
+        }();
+        return tabladas[n];
+    }
+
+    // los elementos de un std::map no se mueven, asi que las referencias siguen validas
+    static std::map<std::pair<FamiliaGauss, int>, ReglaGauss> cache;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto clave = std::make_pair(familia, n);
+    auto it = cache.find(clave);
+    if (it != cache.end()) return it->second;
+
+    ReglaGauss regla;
+    switch (familia)
+    {
+    case FamiliaGauss::LEGENDRE: regla = calcularLegendre(n); break;
+    case FamiliaGauss::LAGUERRE: regla = calcularLaguerre(n); break;
+    case FamiliaGauss::HERMITE: regla = calcularHermite(n); break;
+    case FamiliaGauss::CHEBYSHEV: regla = calcularChebyshev(n); break;
+    }
+    return cache.emplace(clave, std::move(regla)).first->second;
+}
+
+double integrarGauss(FamiliaGauss familia, int n, const std::function<double(double)>& f)
+{
+    const ReglaGauss& regla = reglaGauss(familia, n);
+    double suma = 0.0;
+    for (std::size_t i = 0; i < regla.nodos.size(); ++i) suma += regla.pesos[i] * f(regla.nodos[i]);
+    return suma;
+}
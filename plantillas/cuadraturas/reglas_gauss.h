@@ -0,0 +1,180 @@
+#ifndef REGLAS_GAUSS_H
+#define REGLAS_GAUSS_H
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+// Reglas de cuadratura de Gauss de n puntos:
+//     integral de w(x) f(x) dx  ~  sum_i pesos[i] f(nodos[i])
+// exactas para polinomios de grado <= 2n - 1.
+//
+//     familia      w(x)                  intervalo
+//     LEGENDRE     1                     [-1, 1]
+//     LAGUERRE     e^{-x}                [0, inf)
+//     HERMITE      e^{-x²}               (-inf, inf)
+//     CHEBYSHEV    1 / sqrt(1 - x²)      [-1, 1]
+//
+// Los nodos se calculan con Newton sobre la recurrencia de tres términos de cada familia
+// (Chebyshev tiene fórmula cerrada), con precisión de máquina. Cada regla se calcula una
+// sola vez y queda guardada; Gauss-Legendre hasta 20 puntos sale además de las tablas
+// constexpr de abajo, sin calcular nada. Si Newton no converge o los nodos no salen
+// estrictamente crecientes, reglaGauss lanza std::runtime_error y no guarda la regla.
+enum class FamiliaGauss { LEGENDRE, LAGUERRE, HERMITE, CHEBYSHEV };
+
+struct ReglaGauss
+{
+    std::vector<double> nodos;  // en orden creciente
+    std::vector<double> pesos;
+};
+
+// Regla de n puntos (n >= 1) de la familia; la referencia es válida durante todo el
+// programa. Se puede llamar desde varios hilos.
+const ReglaGauss& reglaGauss(FamiliaGauss familia, int n);
+
+// sum_i pesos[i] f(nodos[i]) con la regla de n puntos
+double integrarGauss(FamiliaGauss familia, int n, const std::function<double(double)>& f);
+
+// Gauss-Legendre en [-1, 1] para n = 1..20, calculadas con 50 dígitos: para cada n, los
+// nodos no negativos en orden decreciente (el 0 al final si n es impar) con su peso; los
+// nodos negativos son los simétricos. La regla de n puntos ocupa las filas
+// [inicio_tabla_legendre[n - 1], inicio_tabla_legendre[n]).
+constexpr int max_orden_tabla_legendre = 20;
+
+constexpr int inicio_tabla_legendre[max_orden_tabla_legendre + 1] = {
+    0, 1, 2, 4, 6, 9, 12, 16, 20, 25, 30, 36, 42, 49, 56, 64, 72, 81, 90, 100, 110};
+
+constexpr double tabla_legendre[110][2] = {
+        // n = 1
+        {0.0, 2.0},
+        // n = 2
+        {0.57735026918962573, 1.0},
+        // n = 3
+        {0.7745966692414834, 0.55555555555555558},
+        {0.0, 0.88888888888888884},
+        // n = 4
+        {0.86113631159405257, 0.34785484513745385},
+        {0.33998104358485626, 0.65214515486254609},
+        // n = 5
+        {0.90617984593866396, 0.23692688505618908},
+        {0.53846931010568311, 0.47862867049936647},
+        {0.0, 0.56888888888888889},
+        // n = 6
+        {0.93246951420315205, 0.17132449237917036},
+        {0.66120938646626448, 0.36076157304813861},
+        {0.2386191860831969, 0.46791393457269104},
+        // n = 7
+        {0.94910791234275849, 0.1294849661688697},
+        {0.74153118559939446, 0.27970539148927664},
+        {0.40584515137739718, 0.38183005050511892},
+        {0.0, 0.4179591836734694},
+        // n = 8
+        {0.96028985649753629, 0.10122853629037626},
+        {0.79666647741362673, 0.22238103445337448},
+        {0.52553240991632899, 0.31370664587788727},
+        {0.18343464249564981, 0.36268378337836199},
+        // n = 9
+        {0.96816023950762609, 0.081274388361574412},
+        {0.83603110732663577, 0.1806481606948574},
+        {0.61337143270059036, 0.26061069640293544},
+        {0.32425342340380892, 0.31234707704000286},
+        {0.0, 0.33023935500125978},
+        // n = 10
+        {0.97390652851717174, 0.066671344308688138},
+        {0.86506336668898454, 0.14945134915058059},
+        {0.67940956829902444, 0.21908636251598204},
+        {0.43339539412924721, 0.26926671930999635},
+        {0.14887433898163122, 0.29552422471475287},
+        // n = 11
+        {0.97822865814605697, 0.055668567116173663},
+        {0.88706259976809532, 0.12558036946490461},
+        {0.73015200557404936, 0.18629021092773426},
+        {0.51909612920681181, 0.23319376459199048},
+        {0.26954315595234496, 0.26280454451024665},
+        {0.0, 0.27292508677790062},
+        // n = 12
+        {0.98156063424671924, 0.047175336386511828},
+        {0.90411725637047491, 0.10693932599531843},
+        {0.76990267419430469, 0.16007832854334622},
+        {0.58731795428661748, 0.20316742672306592},
+        {0.36783149899818018, 0.23349253653835481},
+        {0.12523340851146891, 0.24914704581340277},
+        // n = 13
+        {0.98418305471858814, 0.040484004765315877},
+        {0.91759839922297792, 0.092121499837728452},
+        {0.80157809073330988, 0.13887351021978725},
+        {0.64234933944034023, 0.17814598076194574},
+        {0.44849275103644687, 0.20781604753688851},
+        {0.2304583159551348, 0.22628318026289723},
+        {0.0, 0.2325515532308739},
+        // n = 14
+        {0.98628380869681231, 0.03511946033175186},
+        {0.92843488366357352, 0.080158087159760208},
+        {0.82720131506976502, 0.12151857068790319},
+        {0.68729290481168548, 0.15720316715819355},
+        {0.5152486363581541, 0.18553839747793782},
+        {0.31911236892788974, 0.2051984637212956},
+        {0.10805494870734367, 0.21526385346315779},
+        // n = 15
+        {0.98799251802048538, 0.030753241996117269},
+        {0.93727339240070595, 0.070366047488108124},
+        {0.84820658341042721, 0.10715922046717194},
+        {0.72441773136017007, 0.13957067792615432},
+        {0.57097217260853883, 0.16626920581699392},
+        {0.39415134707756339, 0.18616100001556221},
+        {0.20119409399743451, 0.19843148532711158},
+        {0.0, 0.20257824192556129},
+        // n = 16
+        {0.98940093499164994, 0.027152459411754096},
+        {0.9445750230732326, 0.062253523938647894},
+        {0.86563120238783176, 0.095158511682492786},
+        {0.755404408355003, 0.12462897125553388},
+        {0.61787624440264377, 0.14959598881657674},
+        {0.45801677765722737, 0.16915651939500254},
+        {0.28160355077925892, 0.18260341504492358},
+        {0.095012509837637441, 0.1894506104550685},
+        // n = 17
+        {0.99057547531441736, 0.024148302868547931},
+        {0.9506755217687678, 0.055459529373987203},
+        {0.88023915372698591, 0.085036148317179178},
+        {0.78151400389680137, 0.11188384719340397},
+        {0.65767115921669073, 0.13513636846852548},
+        {0.51269053708647694, 0.15404576107681028},
+        {0.3512317634538763, 0.16800410215645004},
+        {0.17848418149584785, 0.17656270536699264},
+        {0.0, 0.17944647035620653},
+        // n = 18
+        {0.9915651684209309, 0.021616013526483312},
+        {0.95582394957139771, 0.049714548894969797},
+        {0.8926024664975557, 0.076425730254889052},
+        {0.80370495897252314, 0.10094204410628717},
+        {0.69168704306035322, 0.12255520671147846},
+        {0.55977083107394754, 0.14064291467065065},
+        {0.41175116146284263, 0.15468467512626524},
+        {0.25188622569150548, 0.16427648374583273},
+        {0.084775013041735306, 0.1691423829631436},
+        // n = 19
+        {0.99240684384358435, 0.019461788229726478},
+        {0.96020815213483002, 0.0448142267656996},
+        {0.9031559036148179, 0.069044542737641226},
+        {0.82271465653714282, 0.091490021622449999},
+        {0.72096617733522939, 0.11156664554733399},
+        {0.60054530466168099, 0.12875396253933621},
+        {0.46457074137596094, 0.1426067021736066},
+        {0.31656409996362983, 0.15276604206585967},
+        {0.16035864564022537, 0.15896884339395434},
+        {0.0, 0.1610544498487837},
+        // n = 20
+        {0.99312859918509488, 0.017614007139152118},
+        {0.96397192727791381, 0.040601429800386939},
+        {0.91223442825132595, 0.062672048334109068},
+        {0.83911697182221878, 0.083276741576704755},
+        {0.7463319064601508, 0.10193011981724044},
+        {0.63605368072651502, 0.11819453196151841},
+        {0.51086700195082713, 0.13168863844917664},
+        {0.37370608871541955, 0.14209610931838204},
+        {0.22778585114164507, 0.14917298647260374},
+        {0.076526521133497338, 0.15275338713072584}
+};
+
+#endif
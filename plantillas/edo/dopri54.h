@@ -0,0 +1,97 @@
+#ifndef DOPRI54_H
+#define DOPRI54_H
+
+#include <string>
+#include <functional>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include "trajectory_sink.h"
+
+// Opciones de dopri54 (también accesibles como dopri54::Opciones).
+struct dopri54_opciones
+{
+    double rtol = 1e-6;                     // tolerancia relativa (para todas las componentes)
+    double atol = 1e-9;                     // tolerancia absoluta (para todas las componentes)
+    std::vector<double> rtol_componentes;   // si no está vacío, una tolerancia por componente
+    std::vector<double> atol_componentes;
+    double h_inicial = 0.0;                 // 0: se estima a partir de f(t0, y0)
+    double h_max = std::numeric_limits<double>::infinity();
+    std::size_t max_pasos = 10000000;       // pasos (aceptados y rechazados) antes de abortar
+};
+
+// Integrador adaptativo de Dormand-Prince 5(4) (el par de ode45/dopri5).
+//
+// Cada paso da una solución de orden 5 y una estimación del error con la de orden 4
+// usando las mismas etapas. La última etapa se evalúa en el punto nuevo y se reutiliza
+// como primera etapa del paso siguiente (FSAL), así que un paso aceptado cuesta 6
+// evaluaciones de f (rk4::integrar_adaptativo, que duplica el paso, usa 11).
+//
+// El error se mide por componente con tolerancias absolutas y relativas:
+//     err = sqrt( (1/n) sum_i (e_i / (atol_i + rtol_i max(|y_i|, |y_nuevo_i|)))² )
+// y el paso se acepta si err <= 1. El paso siguiente lo elige un controlador PI (usa el
+// error actual y el del paso anterior), que evita las oscilaciones de h del control
+// clásico. No hay un paso máximo salvo que se pida con Opciones::h_max.
+//
+// Salida densa: después de cada paso aceptado se puede evaluar la solución en cualquier
+// t del intervalo [t_anterior(), t_actual()] con un polinomio de orden 4, sin evaluar f.
+// Así la salida en tiempos fijos no obliga a achicar los pasos.
+class dopri54
+{
+public:
+    using ODEFunction = std::function<std::vector<double>(double, const std::vector<double>&)>;
+    // Escribe f(t, y) en dydt, que ya tiene el tamaño de y.
+    using ODEFunctionInPlace = std::function<void(double, const std::vector<double>&, std::vector<double>&)>;
+
+    using Opciones = dopri54_opciones;
+
+    // Llamado después de cada paso aceptado (y una vez al inicio, con t_anterior() = t_actual()).
+    using Observador = std::function<void(const dopri54&)>;
+
+private:
+    ODEFunctionInPlace f;
+    Opciones opciones;
+
+    // Etapas y vectores auxiliares; se dimensionan al comenzar cada integración.
+    std::vector<double> k1, k2, k3, k4, k5, k6, k7, y_temp, y_nuevo, error_local;
+    std::vector<double> y;
+    std::vector<double> rcont1, rcont2, rcont3, rcont4, rcont5; // salida densa
+    double t_ant = 0.0, t_act = 0.0;
+
+    std::size_t n_evaluaciones = 0, n_aceptados = 0, n_rechazados = 0;
+
+    double escala(std::size_t i, double y_a, double y_b) const;
+    double h_inicial_estimado(double t0, double tf);
+    double intentar_paso(double t, double h);  // retorna el error normalizado
+    void preparar_salida_densa(double h);
+
+public:
+    dopri54(const ODEFunction& f, const Opciones& opciones = Opciones());
+    dopri54(const ODEFunctionInPlace& f, const Opciones& opciones = Opciones());
+
+    // Integra desde (t0, y0) hasta tf y retorna y(tf).
+    std::vector<double> integrar(const std::vector<double>& y0, double t0, double tf, const Observador& observador = nullptr);
+
+    // Escribe el estado inicial y el de cada paso aceptado.
+    std::vector<double> integrar(const std::vector<double>& y0, double t0, double tf, TrajectorySink& salida);
+    std::vector<double> integrar(const std::vector<double>& y0, double t0, double tf, const std::string& archivo_salida);
+
+    // Escribe solo los estados en los tiempos pedidos (crecientes, dentro de [t0, tf]),
+    // obtenidos con la salida densa.
+    std::vector<double> integrar(const std::vector<double>& y0, double t0, double tf,
+                                 const std::vector<double>& tiempos, TrajectorySink& salida);
+
+    // --- Estado del último paso aceptado (para usar desde un Observador) ---
+    double t_anterior() const { return t_ant; }
+    double t_actual() const { return t_act; }
+    const std::vector<double>& estado() const { return y; }
+    // Solución en t, con t_anterior() <= t <= t_actual(). 'res' debe tener el tamaño de y.
+    void interpolar(double t, std::vector<double>& res) const;
+
+    // --- Estadísticas de la última integración ---
+    std::size_t evaluaciones() const { return n_evaluaciones; }
+    std::size_t pasos_aceptados() const { return n_aceptados; }
+    std::size_t pasos_rechazados() const { return n_rechazados; }
+};
+
+#endif
@@ -2,56 +2,75 @@
 #include <fstream>
 #include <cmath>
 #include <iomanip>
+#include <utility>
 #include "rk_4.h"
 
-rk4::rk4(const ODEFunction& f) : f(f) {}
+rk4::rk4(const ODEFunction& f)
+    : f([f](double t, const std::vector<double>& y, std::vector<double>& dydt) { dydt = f(t, y); }) {}
+
+rk4::rk4(const ODEFunctionInPlace& f) : f(f) {}
+
+void rk4::Workspace::resize(std::size_t n) {
+    k1.resize(n);
+    k2.resize(n);
+    k3.resize(n);
+    k4.resize(n);
+    temp.resize(n);
+}
+
+void rk4::paso(double t, std::vector<double>& y, double h) {
+    ws.resize(y.size());
+    rk4_step(t, y, h, f, ws, y);
+}
 
 void rk4::integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, const std::string& archivo_salida) {
-    std::ofstream data(archivo_salida);
-    data << "# t";
-    for (size_t i = 0; i < y0.size(); ++i) data << "\ty" << i;
-    data << "\n";
-    data << std::scientific << std::setprecision(10);
+    TextTrajectorySink data(archivo_salida);
+    integrar_paso_fijo(y0, t0, tf, h, data);
+}
+
+void rk4::integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, TrajectorySink& data) {
+    data.begin(y0.size());
 
     std::vector<double> y = y0;
+    ws.resize(y.size());
     double t = t0;
     while (t <= tf) {
-        data << t;
-        for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
-        data << "\n";
-        y = rk4_step(t, y, h, f);
+        data.write(t, y);
+        rk4_step(t, y, h, f, ws, y);
         t += h;
         if (t > tf && tf - (t-h) > 1e-12) {
             t = tf;
-            y = rk4_step(t-h, y, tf-(t-h), f);
-            data << t;
-            for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
-            data << "\n";
+            rk4_step(t-h, y, tf-(t-h), f, ws, y);
+            data.write(t, y);
         }
     }
-    data.close();
+    data.finish();
 }
 
 void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, const std::string& archivo_salida) {
+    TextTrajectorySink data(archivo_salida);
+    integrar_adaptativo(y0, t0, tf, h_inicial, tol, data);
+}
+
+void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, TrajectorySink& data) {
     double t = t0;
     double h = h_inicial;
     const double h_max = 1e-2;
     const double h_min = 1e-10;
 
-    std::ofstream data(archivo_salida);
-    data << "# t";
-    for (size_t i = 0; i < y0.size(); ++i) data << "\ty" << i;
-    data << "\n";
-    data << std::scientific << std::setprecision(10);
+    data.begin(y0.size());
 
+    // Todos los vectores se reservan antes del ciclo; los pasos solo escriben en ellos.
     std::vector<double> y = y0;
+    std::vector<double> y_full(y.size()), y_half(y.size()), y_half_2(y.size());
+    ws.resize(y.size());
     while (t < tf) {
         if (t + h > tf) h = tf - t;
 
-        std::vector<double> y_full = rk4_step(t, y, h, f);
+        rk4_step(t, y, h, f, ws, y_full);
         double h_half = h / 2.0;
-        std::vector<double> y_half = rk4_step(t, y, h_half, f);
-        std::vector<double> y_half_2 = rk4_step(t + h_half, y_half, h_half, f);
+        rk4_step(t, y, h_half, f, ws, y_half);
+        rk4_step(t + h_half, y_half, h_half, f, ws, y_half_2);
         // Calcular el error directamente
         double error = 0.0;
         for (size_t i = 0; i < y_full.size(); ++i)
@@ -59,10 +78,8 @@ void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double t
         error = std::sqrt(error);
 
         if (error <= tol) {
-            data << t;
-            for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
-            data << "\n";
-            y = y_half_2;
+            data.write(t, y);
+            std::swap(y, y_half_2);
             t += h;
         }
 
@@ -71,30 +88,31 @@ void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double t
         if (h > h_max) h = h_max;
         if (h < h_min) h = h_min;
     }
-    data.close();
+    data.finish();
 }
 
-std::vector<double> rk4::rk4_step(double t, const std::vector<double>& y, double h, const ODEFunction& f) {
-    std::vector<double> k1 = f(t, y);
-    std::vector<double> k2(y.size()), k3(y.size()), k4(y.size()), temp(y.size()), result(y.size());
+void rk4::rk4_step(double t, const std::vector<double>& y, double h, const ODEFunctionInPlace& f,
+                   Workspace& ws, std::vector<double>& y_out) {
+    const size_t n = y.size();
+    f(t, y, ws.k1);
 
     // k2 = f(t + 0.5 * h, y + 0.5 * h * k1)
-    for (size_t i = 0; i < y.size(); ++i)
-        temp[i] = y[i] + 0.5 * h * k1[i];
-    k2 = f(t + 0.5 * h, temp);
+    for (size_t i = 0; i < n; ++i)
+        ws.temp[i] = y[i] + 0.5 * h * ws.k1[i];
+    f(t + 0.5 * h, ws.temp, ws.k2);
 
     // k3 = f(t + 0.5 * h, y + 0.5 * h * k2)
-    for (size_t i = 0; i < y.size(); ++i)
-        temp[i] = y[i] + 0.5 * h * k2[i];
-    k3 = f(t + 0.5 * h, temp);
+    for (size_t i = 0; i < n; ++i)
+        ws.temp[i] = y[i] + 0.5 * h * ws.k2[i];
+    f(t + 0.5 * h, ws.temp, ws.k3);
 
     // k4 = f(t + h, y + h * k3)
-    for (size_t i = 0; i < y.size(); ++i)
-        temp[i] = y[i] + h * k3[i];
-    k4 = f(t + h, temp);
-
-    // result = y + (h/6) * (k1 + 2*k2 + 2*k3 + k4)
-    for (size_t i = 0; i < y.size(); ++i)
-        result[i] = y[i] + (h / 6.0) * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
-    return result;
-}
\ No newline at end of file
+    for (size_t i = 0; i < n; ++i)
+        ws.temp[i] = y[i] + h * ws.k3[i];
+    f(t + h, ws.temp, ws.k4);
+
+    // y_out = y + (h/6) * (k1 + 2*k2 + 2*k3 + k4); cada componente solo usa y[i], así
+    // que y_out puede ser y.
+    for (size_t i = 0; i < n; ++i)
+        y_out[i] = y[i] + (h / 6.0) * (ws.k1[i] + 2.0 * ws.k2[i] + 2.0 * ws.k3[i] + ws.k4[i]);
+}
@@ -5,21 +5,46 @@
 #include <string>
 #include <functional>
 #include <vector>
+#include "trajectory_sink.h"
 
 class rk4
 {
 public:
     using ODEFunction = std::function<std::vector<double>(double, const std::vector<double>&)>;
+    // Lado derecho "en el lugar": escribe f(t, y) en dydt, que ya tiene el tamaño de y.
+    // Con esta forma un paso no reserva memoria.
+    using ODEFunctionInPlace = std::function<void(double, const std::vector<double>&, std::vector<double>&)>;
+
+    // Etapas de un paso de RK4. Se reservan una vez (resize) y se reutilizan en cada paso.
+    struct Workspace
+    {
+        std::vector<double> k1, k2, k3, k4, temp;
+        void resize(std::size_t n);
+    };
 
 private:
-    ODEFunction f;
-    static std::vector<double> rk4_step(double t, const std::vector<double>& y, double h, const ODEFunction& f);
+    ODEFunctionInPlace f;
+    Workspace ws;
 
 public:
     rk4(const ODEFunction& f);
+    rk4(const ODEFunctionInPlace& f);
+
+    // Un paso de RK4: y_out = y + h/6 (k1 + 2 k2 + 2 k3 + k4). y_out puede ser el mismo
+    // vector que y. No reserva memoria si ws ya tiene el tamaño de y e y_out también.
+    static void rk4_step(double t, const std::vector<double>& y, double h, const ODEFunctionInPlace& f,
+                         Workspace& ws, std::vector<double>& y_out);
+    // Avanza y en el lugar usando el espacio de trabajo interno.
+    void paso(double t, std::vector<double>& y, double h);
+
     void integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, const std::string& archivo_salida);
     void integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, const std::string& archivo_salida);
 
+    // Igual que las anteriores, pero escriben los estados en un destino cualquiera
+    // (por ejemplo BinaryTrajectorySink). Las versiones con nombre de archivo usan texto.
+    void integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, TrajectorySink& salida);
+    void integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, TrajectorySink& salida);
+
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,489 @@
+#ifndef QR_H
+#define QR_H
+
+#include <vector>      // Para std::vector
+#include <cmath>       // Para std::sqrt, std::abs
+#include <limits>      // Para std::numeric_limits
+#include <type_traits> // Para std::is_floating_point_v
+#include <stdexcept>   // Para std::invalid_argument, std::runtime_error
+#include <algorithm>   // Para std::min, std::max, std::swap
+#include <numeric>     // Para std::iota
+#include <cstddef>     // Para std::size_t
+
+#include "Matrix.h"
+
+/* --- HouseholderQR Class Declaration --- */
+// Factorización A P = Q R con reflexiones de Householder, para matrices m x n con m >= n
+// (altas, como la matriz de diseño de una regresión). Q no se forma: cada reflexión
+// H_j = I - tau_j v_j v_jᵀ se guarda como el vector v_j bajo la diagonal (con v_j(j) = 1
+// implícito) y su escalar tau_j. R queda en la diagonal y encima.
+//
+// Sin pivoteo se usa la variante por bloques (representación WY compacta): cada panel de
+// nb columnas se factoriza columna a columna y su producto de reflexiones se escribe como
+// Q_panel = I - V T Vᵀ, con T triangular superior de nb x nb. El resto de la matriz se
+// actualiza con dos productos gemm: W = Vᵀ A2 y A2 -= V (Tᵀ W).
+//
+// Con pivoteo de columnas (P ≠ I) se elige en cada paso la columna de mayor norma
+// restante. Esto revela el rango numérico de A y permite resolver problemas con
+// columnas colineales; se hace sin bloques porque cada paso depende de las normas.
+//
+// Todos los recorridos de la matriz se hacen por filas, que es como está almacenada.
+
+// Tamaño de bloque (columnas por panel) por defecto de la factorización QR por bloques.
+inline constexpr std::size_t qr_default_block_size = 32;
+
+template <class T>
+class HouseholderQR
+{
+    static_assert(std::is_floating_point_v<T>, "HouseholderQR requiere un tipo de punto flotante.");
+
+private:
+    Matrix<T> qr_;                    // R (diagonal y encima) y los vectores v_j (bajo la diagonal).
+    std::vector<T> tau_;              // Escalares de las reflexiones.
+    std::vector<std::size_t> perm_;   // perm_[j] = columna de A que terminó en la columna j.
+    bool pivoting_ = false;
+    std::size_t rank_ = 0;
+
+    // Genera la reflexión que anula qr_(j+1:m, j) y guarda v_j bajo la diagonal.
+    void make_reflector(std::size_t j) {
+        const std::size_t m = qr_.rows();
+        const std::size_t ld = qr_.leading_dim();
+        T* a = qr_.data_ptr();
+
+        const T alpha = a[j * ld + j];
+        T sigma = T(0);
+        for (std::size_t r = j + 1; r < m; ++r) {
+            sigma += a[r * ld + j] * a[r * ld + j];
+        }
+        if (sigma == T(0)) {
+            tau_[j] = T(0); // La columna ya es un múltiplo de e_j.
+            return;
+        }
+        T beta = std::sqrt(alpha * alpha + sigma);
+        if (alpha > T(0)) beta = -beta; // Evita la cancelación en alpha - beta.
+        tau_[j] = (beta - alpha) / beta;
+        const T scale = T(1) / (alpha - beta);
+        for (std::size_t r = j + 1; r < m; ++r) {
+            a[r * ld + j] *= scale;
+        }
+        a[j * ld + j] = beta;
+    }
+
+    // Aplica H_j a las columnas [c0, c1) de qr_ (filas j..m-1): w = tau vᵀ A y A -= v w.
+    void apply_reflector(std::size_t j, std::size_t c0, std::size_t c1, std::vector<T>& w) {
+        if (c0 >= c1 || tau_[j] == T(0)) return;
+        const std::size_t m = qr_.rows();
+        const std::size_t ld = qr_.leading_dim();
+        const std::size_t width = c1 - c0;
+        T* a = qr_.data_ptr();
+
+        w.assign(a + j * ld + c0, a + j * ld + c1);
+        for (std::size_t r = j + 1; r < m; ++r) {
+            const T v = a[r * ld + j];
+            const T* row = a + r * ld + c0;
+            for (std::size_t c = 0; c < width; ++c) w[c] += v * row[c];
+        }
+        for (std::size_t c = 0; c < width; ++c) w[c] *= tau_[j];
+
+        T* row_j = a + j * ld + c0;
+        for (std::size_t c = 0; c < width; ++c) row_j[c] -= w[c];
+        for (std::size_t r = j + 1; r < m; ++r) {
+            const T v = a[r * ld + j];
+            T* row = a + r * ld + c0;
+            for (std::size_t c = 0; c < width; ++c) row[c] -= v * w[c];
+        }
+    }
+
+    // Actualiza las columnas a la derecha del panel [k0, k0 + kb) con Q_panelᵀ.
+    void update_trailing(std::size_t k0, std::size_t kb) {
+        const std::size_t m = qr_.rows();
+        const std::size_t n = qr_.cols();
+        const std::size_t m2 = m - k0;
+        const std::size_t c0 = k0 + kb;
+        const std::size_t n2 = n - c0;
+
+        // V explícita (m2 x kb): unos en la diagonal y ceros encima.
+        Matrix<T> V(m2, kb);
+        for (std::size_t i = 0; i < m2; ++i) {
+            for (std::size_t jj = 0; jj < kb && jj <= i; ++jj) {
+                V(i, jj) = (i == jj) ? T(1) : qr_(k0 + i, k0 + jj);
+            }
+        }
+        const MatrixView<const T> Vt(V.data_ptr(), kb, m2, 1, V.leading_dim());
+
+        // T triangular superior: T(0:j, j) = -tau_j T(0:j, 0:j) Vᵀ v_j, con S = VᵀV.
+        Matrix<T> S(kb, kb);
+        gemm(T(1), Vt, MatrixView<const T>(V.view()), S.view());
+        Matrix<T> Tm(kb, kb);
+        for (std::size_t j = 0; j < kb; ++j) {
+            const T tau_j = tau_[k0 + j];
+            Tm(j, j) = tau_j;
+            for (std::size_t i = 0; i < j; ++i) {
+                T sum = T(0);
+                for (std::size_t l = i; l < j; ++l) sum += Tm(i, l) * S(l, j);
+                Tm(i, j) = -tau_j * sum;
+            }
+        }
+
+        // A2 -= V Tᵀ (Vᵀ A2).
+        MatrixView<T> A2 = qr_.view().block(k0, c0, m2, n2);
+        Matrix<T> W(kb, n2);
+        gemm(T(1), Vt, MatrixView<const T>(A2), W.view());
+        for (std::size_t i = kb; i-- > 0;) { // W = Tᵀ W (de abajo hacia arriba, en el lugar).
+            T* w_i = W.data_ptr() + i * W.leading_dim();
+            for (std::size_t c = 0; c < n2; ++c) w_i[c] *= Tm(i, i);
+            for (std::size_t l = 0; l < i; ++l) {
+                const T t = Tm(l, i);
+                const T* w_l = W.data_ptr() + l * W.leading_dim();
+                for (std::size_t c = 0; c < n2; ++c) w_i[c] += t * w_l[c];
+            }
+        }
+        gemm(T(-1), MatrixView<const T>(V.view()), MatrixView<const T>(W.view()), A2);
+    }
+
+    void factor_blocked(std::size_t block_size) {
+        const std::size_t n = qr_.cols();
+        const std::size_t k = std::min(qr_.rows(), n);
+        block_size = std::max<std::size_t>(1, block_size);
+        std::vector<T> w;
+        for (std::size_t k0 = 0; k0 < k; k0 += block_size) {
+            const std::size_t kb = std::min(block_size, k - k0);
+            for (std::size_t j = k0; j < k0 + kb; ++j) {
+                make_reflector(j);
+                apply_reflector(j, j + 1, k0 + kb, w);
+            }
+            if (k0 + kb < n) {
+                update_trailing(k0, kb);
+            }
+        }
+    }
+
+    void factor_pivoted() {
+        const std::size_t m = qr_.rows();
+        const std::size_t n = qr_.cols();
+        const std::size_t k = std::min(m, n);
+        const std::size_t ld = qr_.leading_dim();
+        T* a = qr_.data_ptr();
+
+        // Normas² de las columnas restantes (se actualizan en cada paso).
+        std::vector<T> norms(n, T(0));
+        for (std::size_t r = 0; r < m; ++r) {
+            for (std::size_t c = 0; c < n; ++c) norms[c] += a[r * ld + c] * a[r * ld + c];
+        }
+        std::vector<T> original = norms;
+        const T tol = std::sqrt(std::numeric_limits<T>::epsilon());
+        std::vector<T> w;
+
+        for (std::size_t j = 0; j < k; ++j) {
+            std::size_t p = j;
+            for (std::size_t c = j + 1; c < n; ++c) {
+                if (norms[c] > norms[p]) p = c;
+            }
+            if (p != j) {
+                for (std::size_t r = 0; r < m; ++r) std::swap(a[r * ld + j], a[r * ld + p]);
+                std::swap(norms[j], norms[p]);
+                std::swap(original[j], original[p]);
+                std::swap(perm_[j], perm_[p]);
+            }
+            make_reflector(j);
+            apply_reflector(j, j + 1, n, w);
+
+            // Baja las normas; si se pierde demasiada precisión, las recalcula.
+            for (std::size_t c = j + 1; c < n; ++c) {
+                norms[c] -= a[j * ld + c] * a[j * ld + c];
+                if (norms[c] <= tol * original[c]) {
+                    T sum = T(0);
+                    for (std::size_t r = j + 1; r < m; ++r) sum += a[r * ld + c] * a[r * ld + c];
+                    norms[c] = sum;
+                    original[c] = sum;
+                }
+            }
+        }
+    }
+
+public:
+    HouseholderQR() = default;
+
+    // Factoriza A (se toma por valor para poder moverla y factorizar en el lugar).
+    explicit HouseholderQR(Matrix<T> A, bool column_pivoting = false, std::size_t block_size = qr_default_block_size)
+        : qr_(std::move(A)), pivoting_(column_pivoting) {
+        const std::size_t m = qr_.rows();
+        const std::size_t n = qr_.cols();
+        const std::size_t k = std::min(m, n);
+        tau_.assign(k, T(0));
+        perm_.resize(n);
+        std::iota(perm_.begin(), perm_.end(), std::size_t(0));
+
+        if (pivoting_) {
+            factor_pivoted();
+        } else {
+            factor_blocked(block_size);
+        }
+
+        set_rank_tolerance(T(std::max(m, n)) * std::numeric_limits<T>::epsilon());
+    }
+
+    // Rango numérico: número de |R(i, i)| > relative_tol * max |R(j, j)|.
+    // Por defecto relative_tol = max(m, n) * eps.
+    void set_rank_tolerance(T relative_tol) {
+        const std::size_t k = std::min(qr_.rows(), qr_.cols());
+        T max_diag = T(0);
+        for (std::size_t i = 0; i < k; ++i) max_diag = std::max(max_diag, std::abs(qr_(i, i)));
+        const T tol = relative_tol * max_diag;
+        rank_ = 0;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (std::abs(qr_(i, i)) > tol) ++rank_;
+        }
+    }
+
+    std::size_t rows() const { return qr_.rows(); }
+    std::size_t cols() const { return qr_.cols(); }
+    std::size_t rank() const { return rank_; }
+    bool is_full_rank() const { return rank_ == qr_.cols(); }
+    const std::vector<std::size_t>& permutation() const { return perm_; }
+
+    // Retorna R (min(m, n) x n, triangular superior).
+    Matrix<T> R() const {
+        const std::size_t k = std::min(qr_.rows(), qr_.cols());
+        Matrix<T> res(k, qr_.cols());
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = i; j < qr_.cols(); ++j) {
+                res(i, j) = qr_(i, j);
+            }
+        }
+        return res;
+    }
+
+    // b <- Qᵀ b.
+    void apply_qt(std::vector<T>& b) const {
+        if (b.size() != qr_.rows()) {
+            throw std::invalid_argument("Error: El vector no tiene el mismo número de filas que la matriz factorizada.");
+        }
+        const std::size_t m = qr_.rows();
+        const std::size_t ld = qr_.leading_dim();
+        const T* a = qr_.data_ptr();
+        for (std::size_t j = 0; j < tau_.size(); ++j) {
+            if (tau_[j] == T(0)) continue;
+            T w = b[j];
+            for (std::size_t r = j + 1; r < m; ++r) w += a[r * ld + j] * b[r];
+            w *= tau_[j];
+            b[j] -= w;
+            for (std::size_t r = j + 1; r < m; ++r) b[r] -= a[r * ld + j] * w;
+        }
+    }
+
+    // Solución de mínimos cuadrados de min ||A x - b||: R x = (Qᵀ b)(0:n).
+    // Con pivoteo y rango r < n se retorna la solución básica (n - r componentes nulas).
+    std::vector<T> solve(const std::vector<T>& b) const {
+        const std::size_t n = qr_.cols();
+        const std::size_t r = pivoting_ ? rank_ : n;
+        if (!pivoting_ && (qr_.rows() < n || rank_ < n)) {
+            throw std::runtime_error("Error: La matriz no tiene rango completo. Usa HouseholderQR con pivoteo de columnas.");
+        }
+        std::vector<T> c = b;
+        apply_qt(c);
+
+        const std::size_t ld = qr_.leading_dim();
+        const T* a = qr_.data_ptr();
+        std::vector<T> z(r);
+        for (std::size_t i = r; i-- > 0;) {
+            T sum = c[i];
+            const T* row = a + i * ld;
+            for (std::size_t l = i + 1; l < r; ++l) sum -= row[l] * z[l];
+            z[i] = sum / row[i];
+        }
+        std::vector<T> x(n, T(0));
+        for (std::size_t i = 0; i < r; ++i) x[perm_[i]] = z[i];
+        return x;
+    }
+};
+
+/* --- Mínimos cuadrados por bloques de filas (TSQR) --- */
+// Para una matriz alta X (n >> p) no hace falta factorizarla entera: si R̃ es el factor
+// triangular de las filas ya procesadas, el de esas filas más un bloque nuevo B es el
+// factor QR de [R̃; B]. Se factoriza [X | y], de modo que la última columna de R̃ contiene
+// Qᵀy y el elemento (p, p) es la norma del residuo. Cada bloque de filas cabe en caché,
+// y grupos de bloques se procesan en paralelo y luego se combinan en orden fijo (el
+// resultado no depende del número de hilos).
+
+// Filas de X por bloque y bloques por tarea paralela.
+inline constexpr std::size_t qr_default_chunk_rows = 2048;
+inline constexpr std::size_t qr_chunks_per_task = 16;
+
+// Reemplaza R (q x q, triangular superior) por el factor triangular de [R; rows].
+template <class T>
+void qr_update_triangle(Matrix<T>& R, const MatrixView<const T>& rows) {
+    const std::size_t q = R.rows();
+    if (rows.cols() != q) {
+        throw std::invalid_argument("Error: Las filas nuevas no tienen el mismo número de columnas que R.");
+    }
+    Matrix<T> stacked(q + rows.rows(), q);
+    for (std::size_t i = 0; i < q; ++i) {
+        for (std::size_t j = i; j < q; ++j) stacked(i, j) = R(i, j);
+    }
+    for (std::size_t i = 0; i < rows.rows(); ++i) {
+        T* dst = stacked.data_ptr() + (q + i) * stacked.leading_dim();
+        for (std::size_t j = 0; j < q; ++j) dst[j] = rows(i, j);
+    }
+    HouseholderQR<T> qr(std::move(stacked));
+    R = qr.R();
+}
+
+/* --- QRAccumulator Class Declaration --- */
+// Mínimos cuadrados incremental: acumula el factor triangular de [X | y] a medida que
+// llegan filas, sin guardar X. Las filas se copian a un búfer de chunk_rows filas y cuando
+// se llena se incorporan a R̃ con qr_update_triangle. La memoria es O(p²) (más el búfer de
+// tamaño fijo) sin importar cuántas filas se procesen, y se pueden seguir añadiendo filas
+// después de resolver: solve() no modifica lo acumulado.
+template <class T>
+class QRAccumulator
+{
+private:
+    std::size_t p_ = 0;             // Número de columnas de X.
+    std::size_t chunk_rows_ = 0;
+    Matrix<T> R_;                   // Factor triangular de [X | y] ((p+1) x (p+1)).
+    Matrix<T> buffer_;              // Filas [x | y] aún no incorporadas a R_.
+    std::size_t buffered_ = 0;
+    std::size_t count_ = 0;         // Filas añadidas en total.
+
+    // Triangular de lo acumulado incluyendo el búfer (sin vaciarlo).
+    Matrix<T> current_triangle() const {
+        Matrix<T> R = R_;
+        if (buffered_ > 0) {
+            qr_update_triangle(R, buffer_.block(0, 0, buffered_, p_ + 1));
+        }
+        return R;
+    }
+
+public:
+    QRAccumulator() = default;
+
+    explicit QRAccumulator(std::size_t num_columns, std::size_t chunk_rows = qr_default_chunk_rows)
+        : p_(num_columns), chunk_rows_(std::max<std::size_t>(1, chunk_rows)),
+          R_(num_columns + 1, num_columns + 1), buffer_(chunk_rows_, num_columns + 1) {}
+
+    std::size_t num_columns() const { return p_; }
+    std::size_t count() const { return count_; }
+
+    // Añade la fila x (p elementos) con respuesta y.
+    void add_row(const T* x, T y) {
+        T* dst = buffer_.data_ptr() + buffered_ * buffer_.leading_dim();
+        std::copy(x, x + p_, dst);
+        dst[p_] = y;
+        ++count_;
+        if (++buffered_ == chunk_rows_) flush();
+    }
+
+    void add_row(const std::vector<T>& x, T y) {
+        if (x.size() != p_) {
+            throw std::invalid_argument("Error: La fila no tiene el número de columnas del acumulador.");
+        }
+        add_row(x.data(), y);
+    }
+
+    // Añade todas las filas de X con sus respuestas y.
+    void add_rows(const MatrixView<const T>& X, const std::vector<T>& y) {
+        if (X.cols() != p_ || X.rows() != y.size()) {
+            throw std::invalid_argument("Error: Las dimensiones de X e y no son compatibles con el acumulador.");
+        }
+        for (std::size_t i = 0; i < X.rows(); ++i) {
+            T* dst = buffer_.data_ptr() + buffered_ * buffer_.leading_dim();
+            for (std::size_t j = 0; j < p_; ++j) dst[j] = X(i, j);
+            dst[p_] = y[i];
+            ++count_;
+            if (++buffered_ == chunk_rows_) flush();
+        }
+    }
+
+    // Incorpora el búfer a R̃.
+    void flush() {
+        if (buffered_ == 0) return;
+        qr_update_triangle(R_, MatrixView<const T>(buffer_.block(0, 0, buffered_, p_ + 1)));
+        buffered_ = 0;
+    }
+
+    // Combina las filas acumuladas por otro acumulador (por ejemplo, de otro hilo).
+    void merge(const QRAccumulator<T>& other) {
+        if (other.p_ != p_) {
+            throw std::invalid_argument("Error: Los acumuladores no tienen el mismo número de columnas.");
+        }
+        flush();
+        const Matrix<T> other_R = other.current_triangle();
+        qr_update_triangle(R_, other_R.view());
+        count_ += other.count_;
+    }
+
+    // Factor triangular de [X | y] de todas las filas añadidas.
+    Matrix<T> triangle() const { return current_triangle(); }
+
+    // Norma del residuo ||X beta - y|| de la solución de mínimos cuadrados (rango completo).
+    T residual_norm() const { return std::abs(current_triangle()(p_, p_)); }
+
+    // Resuelve min ||X beta - y|| con las filas añadidas hasta ahora. Si column_pivoting es
+    // false y R resulta de rango incompleto, se usa igualmente el pivoteo de columnas sobre
+    // R (solución básica).
+    std::vector<T> solve(bool column_pivoting = false) const {
+        const Matrix<T> R = current_triangle();
+        Matrix<T> Rp(R.block(0, 0, p_, p_));
+        std::vector<T> z(p_);
+        for (std::size_t i = 0; i < p_; ++i) z[i] = R(i, p_);
+
+        // Misma tolerancia de rango que HouseholderQR aplicada a X entera.
+        const T relative_tol = T(std::max(count_, p_)) * std::numeric_limits<T>::epsilon();
+        if (!column_pivoting) {
+            T max_diag = T(0);
+            for (std::size_t i = 0; i < p_; ++i) max_diag = std::max(max_diag, std::abs(Rp(i, i)));
+            const T tol = relative_tol * max_diag;
+            bool full_rank = max_diag > T(0);
+            for (std::size_t i = 0; i < p_ && full_rank; ++i) full_rank = std::abs(Rp(i, i)) > tol;
+            if (full_rank) {
+                std::vector<T> beta(p_);
+                for (std::size_t i = p_; i-- > 0;) {
+                    T sum = z[i];
+                    for (std::size_t l = i + 1; l < p_; ++l) sum -= Rp(i, l) * beta[l];
+                    beta[i] = sum / Rp(i, i);
+                }
+                return beta;
+            }
+        }
+        HouseholderQR<T> pivoted(std::move(Rp), true);
+        pivoted.set_rank_tolerance(relative_tol);
+        return pivoted.solve(z);
+    }
+};
+
+// Resuelve min ||X beta - y|| sin formar XᵀX, procesando X por bloques de filas en paralelo.
+template <class T>
+std::vector<T> least_squares_qr(const Matrix<T>& X, const std::vector<T>& y, bool column_pivoting = false,
+                                std::size_t chunk_rows = qr_default_chunk_rows) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("Error: X e y no tienen el mismo número de filas.");
+    }
+    const std::size_t n = X.rows();
+    const std::size_t p = X.cols();
+    chunk_rows = std::max<std::size_t>(1, chunk_rows);
+    const std::size_t rows_per_task = chunk_rows * qr_chunks_per_task;
+    const std::size_t n_tasks = (n + rows_per_task - 1) / rows_per_task;
+
+    std::vector<QRAccumulator<T>> partial(n_tasks);
+    matrix_thread_pool().parallel_for(0, n_tasks, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t task = first; task < last; ++task) {
+            const std::size_t r0 = task * rows_per_task;
+            const std::size_t r1 = std::min(n, r0 + rows_per_task);
+            QRAccumulator<T> acc(p, chunk_rows);
+            for (std::size_t r = r0; r < r1; ++r) {
+                acc.add_row(X.data_ptr() + r * X.leading_dim(), y[r]);
+            }
+            acc.flush();
+            partial[task] = std::move(acc);
+        }
+    });
+
+    QRAccumulator<T> total(p, chunk_rows);
+    for (std::size_t task = 0; task < n_tasks; ++task) {
+        total.merge(partial[task]);
+    }
+    return total.solve(column_pivoting);
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include "montecarlo_nd.h"
+#include "philox.h"
+#include "secuencias_qmc.h"
+#include <stdexcept>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+MonteCarloIntegratorND::MonteCarloIntegratorND(const std::vector<double>& a, const std::vector<double>& b)
+    : a_(a), b_(b)
+{
+    if (a_.empty() || a_.size() != b_.size())
+        throw std::invalid_argument("MonteCarloIntegratorND: a y b deben tener la misma dimension (al menos 1).");
+    for (std::size_t j = 0; j < a_.size(); ++j)
+        if (a_[j] >= b_[j])
+            throw std::invalid_argument("MonteCarloIntegratorND: se necesita a[j] < b[j] en cada dimension.");
+}
+
+double MonteCarloIntegratorND::promedioReplica(const Funcion& f, long long n, Muestreo muestreo,
+                                               std::uint64_t semilla, int r) const
+{
+    const std::size_t d = dimension();
+    // cada replica tiene su flujo: da los puntos (pseudoaleatorio) o el desplazamiento (QMC)
+    PhiloxStream gen(semilla, std::uint64_t(r));
+    std::vector<double> u(d), x(d);
+
+    // los puntos en [0, 1)^d se llevan al hiperrectangulo
+    auto evaluar = [&]()
+    {
+        for (std::size_t j = 0; j < d; ++j) x[j] = a_[j] + (b_[j] - a_[j]) * u[j];
+        return f(x);
+    };
+
+    // suma con compensacion de Kahan: N/R puede ser muy grande
+    double suma = 0.0, compensacion = 0.0;
+    auto sumar = [&](double valor)
+    {
+        const double y = valor - compensacion;
+        const double t = suma + y;
+        compensacion = (t - suma) - y;
+        suma = t;
+    };
+
+    switch (muestreo)
+    {
+    case Muestreo::PSEUDOALEATORIO:
+    {
+        // puntos por lotes (ver philox.h)
+        const long long lote = 256;
+        std::vector<double> puntos(std::size_t(lote) * d);
+        for (long long i = 0; i < n; i += lote)
+        {
+            const long long m = std::min(lote, n - i);
+            gen.uniformes(puntos.data(), std::size_t(m) * d);
+            for (long long k = 0; k < m; ++k)
+            {
+                std::copy(puntos.begin() + k * d, puntos.begin() + (k + 1) * d, u.begin());
+                sumar(evaluar());
+            }
+        }
+        break;
+    }
+    case Muestreo::HALTON:
+    {
+        std::vector<double> desplazamiento(d);
+        gen.uniformes(desplazamiento.data(), d);
+        Halton secuencia(d);
+        for (long long i = 0; i < n; ++i)
+        {
+            secuencia.siguiente(u.data());
+            for (std::size_t j = 0; j < d; ++j)
+            {
+                const double s = u[j] + desplazamiento[j];
+                u[j] = (s >= 1.0) ? s - 1.0 : s;
+            }
+            sumar(evaluar());
+        }
+        break;
+    }
+    case Muestreo::SOBOL:
+    {
+        std::vector<std::uint32_t> desplazamiento(d), entero(d);
+        for (std::size_t j = 0; j < d; ++j) desplazamiento[j] = gen();
+        Sobol secuencia(d);
+        for (long long i = 0; i < n; ++i)
+        {
+            secuencia.siguienteEntero(entero.data());
+            // el XOR mantiene la estructura de la red digital; el 0.5 evita el borde 0
+            for (std::size_t j = 0; j < d; ++j)
+                u[j] = (double(entero[j] ^ desplazamiento[j]) + 0.5) * (1.0 / 4294967296.0);
+            sumar(evaluar());
+        }
+        break;
+    }
+    }
+    return suma / double(n);
+}
+
+ResultadoMonteCarlo MonteCarloIntegratorND::aproximar(
+    const Funcion& f,
+    long long num_muestras,
+    Muestreo muestreo,
+    std::uint64_t semilla,
+    int replicas,
+    unsigned num_hilos) const
+{
+    if (replicas < 1 || num_muestras < replicas)
+        throw std::invalid_argument("MonteCarloIntegratorND: se necesita 1 <= replicas <= num_muestras.");
+    if (muestreo == Muestreo::SOBOL && dimension() > Sobol::max_dimension)
+        throw std::invalid_argument("MonteCarloIntegratorND: Sobol admite hasta 21 dimensiones.");
+
+    const auto inicio = std::chrono::steady_clock::now();
+    const long long por_replica = num_muestras / replicas;
+    std::vector<double> promedios(std::size_t(replicas), 0.0);
+
+    std::atomic<int> siguiente{0};
+    auto trabajador = [&]
+    {
+        for (int r = siguiente.fetch_add(1); r < replicas; r = siguiente.fetch_add(1))
+            promedios[std::size_t(r)] = promedioReplica(f, por_replica, muestreo, semilla, r);
+    };
+    std::size_t hilos = num_hilos;
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    hilos = std::min(hilos, std::size_t(replicas));
+    std::vector<std::thread> auxiliares;
+    for (std::size_t t = 1; t < hilos; ++t) auxiliares.emplace_back(trabajador);
+    trabajador();
+    for (std::thread& h : auxiliares) h.join();
+
+    // promedio y desviacion de las replicas, siempre en el mismo orden
+    double media = 0.0;
+    for (double p : promedios) media += p;
+    media /= replicas;
+    double m2 = 0.0;
+    for (double p : promedios) m2 += (p - media) * (p - media);
+
+    double volumen = 1.0;
+    for (std::size_t j = 0; j < dimension(); ++j) volumen *= b_[j] - a_[j];
+
+    const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    ResultadoMonteCarlo resultado;
+    resultado.valor = volumen * media;
+    resultado.error = (replicas > 1) ? volumen * std::sqrt(m2 / (replicas - 1.0) / replicas) : 0.0;
+    resultado.muestras = por_replica * replicas;
+    resultado.muestras_por_segundo = (segundos > 0.0) ? double(resultado.muestras) / segundos : 0.0;
+    resultado.varianza = resultado.error * resultado.error * double(resultado.muestras);
+    return resultado;
+}
@@ -0,0 +1,251 @@
+#include "reduccion_varianza.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    const long long lote = 256;
+
+    // media y varianza de una serie de valores (Welford)
+    struct Acumulador
+    {
+        long long n = 0;
+        double media = 0.0;
+        double m2 = 0.0;
+
+        void agregar(double x)
+        {
+            ++n;
+            const double delta = x - media;
+            media += delta / double(n);
+            m2 += delta * (x - media);
+        }
+        double varianza() const { return (n > 1) ? m2 / double(n - 1) : 0.0; }
+    };
+
+    // llama a 'usar(u)' con n uniformes en (0, 1), generados por lotes
+    template <class Usar>
+    void recorrerUniformes(PhiloxStream& gen, long long n, Usar&& usar)
+    {
+        double u[lote];
+        for (long long i = 0; i < n; i += lote)
+        {
+            const long long m = std::min(lote, n - i);
+            gen.uniformes(u, std::size_t(m));
+            for (long long j = 0; j < m; ++j) usar(u[j]);
+        }
+    }
+
+    // resultado con valor y varianza del estimador; 'evaluaciones' es el costo en llamadas a f
+    ResultadoMonteCarlo resultado(double valor, double varianza_estimador, long long evaluaciones)
+    {
+        ResultadoMonteCarlo r;
+        r.valor = valor;
+        r.error = std::sqrt(std::max(0.0, varianza_estimador));
+        r.muestras = evaluaciones;
+        r.varianza = varianza_estimador * double(evaluaciones);
+        return r;
+    }
+
+    void validar(double a, double b, long long n, long long minimo)
+    {
+        if (a >= b) throw std::invalid_argument("El límite inferior 'a' debe ser menor que 'b'.");
+        if (n < minimo) throw std::invalid_argument("Muy pocas muestras para esta estrategia.");
+    }
+}
+
+ResultadoMonteCarlo MuestreoUniforme::estimar(double a, double b, long long n,
+                                              const std::function<double(double)>& f, PhiloxStream& gen)
+{
+    validar(a, b, n, 2);
+    const double ancho = b - a;
+    Acumulador acc;
+    recorrerUniformes(gen, n, [&](double u) { acc.agregar(ancho * f(a + ancho * u)); });
+    return resultado(acc.media, acc.varianza() / double(n), n);
+}
+
+MuestreoEstratificado::MuestreoEstratificado(int estratos) : estratos_(estratos)
+{
+    if (estratos < 1) throw std::invalid_argument("MuestreoEstratificado: se necesita al menos un estrato.");
+}
+
+ResultadoMonteCarlo MuestreoEstratificado::estimar(double a, double b, long long n,
+                                                   const std::function<double(double)>& f, PhiloxStream& gen)
+{
+    // al menos dos muestras por estrato para estimar su varianza
+    validar(a, b, n, 2LL * estratos_);
+    const double w = (b - a) / estratos_;
+    double valor = 0.0, varianza = 0.0;
+    for (int k = 0; k < estratos_; ++k)
+    {
+        // n_k = n / K, el resto se reparte entre los primeros estratos
+        const long long n_k = n / estratos_ + (k < n % estratos_ ? 1 : 0);
+        const double inicio = a + k * w;
+        Acumulador acc;
+        recorrerUniformes(gen, n_k, [&](double u) { acc.agregar(w * f(inicio + w * u)); });
+        valor += acc.media;
+        varianza += acc.varianza() / double(n_k);
+    }
+    return resultado(valor, varianza, n);
+}
+
+ResultadoMonteCarlo MuestreoAntitetico::estimar(double a, double b, long long n,
+                                                const std::function<double(double)>& f, PhiloxStream& gen)
+{
+    validar(a, b, n, 4);
+    const double ancho = b - a;
+    const long long pares = n / 2;
+    Acumulador acc;
+    recorrerUniformes(gen, pares, [&](double u)
+    {
+        const double x = a + ancho * u;
+        acc.agregar(0.5 * ancho * (f(x) + f(a + b - x)));
+    });
+    return resultado(acc.media, acc.varianza() / double(pares), 2 * pares);
+}
+
+MuestreoImportancia::MuestreoImportancia(std::function<double(double)> densidad, std::function<double(double)> inversa)
+    : densidad_(std::move(densidad)), inversa_(std::move(inversa))
+{
+}
+
+ResultadoMonteCarlo MuestreoImportancia::estimar(double a, double b, long long n,
+                                                 const std::function<double(double)>& f, PhiloxStream& gen)
+{
+    validar(a, b, n, 2);
+    Acumulador acc;
+    recorrerUniformes(gen, n, [&](double u)
+    {
+        const double x = inversa_(u);
+        acc.agregar(f(x) / densidad_(x));
+    });
+    return resultado(acc.media, acc.varianza() / double(n), n);
+}
+
+VariableControl::VariableControl(std::function<double(double)> g, double integral_g)
+    : g_(std::move(g)), integral_g_(integral_g)
+{
+}
+
+ResultadoMonteCarlo VariableControl::estimar(double a, double b, long long n,
+                                             const std::function<double(double)>& f, PhiloxStream& gen)
+{
+    validar(a, b, n, 3);
+    const double ancho = b - a;
+    // medias, varianzas y covarianza de (ancho f, ancho g), en una pasada
+    long long k = 0;
+    double media_f = 0.0, media_g = 0.0, m2_f = 0.0, m2_g = 0.0, c_fg = 0.0;
+    recorrerUniformes(gen, n, [&](double u)
+    {
+        const double x = a + ancho * u;
+        const double yf = ancho * f(x), yg = ancho * g_(x);
+        ++k;
+        const double df = yf - media_f, dg = yg - media_g;
+        media_f += df / double(k);
+        media_g += dg / double(k);
+        m2_f += df * (yf - media_f);
+        m2_g += dg * (yg - media_g);
+        c_fg += df * (yg - media_g);
+    });
+    const double beta = (m2_g > 0.0) ? c_fg / m2_g : 0.0;
+    const double valor = media_f - beta * (media_g - integral_g_);
+    // var(f - beta g) = var f - beta cov(f, g); se pierde un grado de libertad por beta
+    const double varianza = std::max(0.0, m2_f - beta * c_fg) / double(n - 2);
+    return resultado(valor, varianza / double(n), n);
+}
+
+MuestreoVegas::MuestreoVegas(int bins, int iteraciones, double alpha)
+    : bins_(bins), iteraciones_(iteraciones), alpha_(alpha)
+{
+    if (bins < 1 || iteraciones < 1 || alpha <= 0.0)
+        throw std::invalid_argument("MuestreoVegas: se necesita bins >= 1, iteraciones >= 1 y alpha > 0.");
+}
+
+// Mueve los bordes para que cada bin nuevo tenga la misma parte de 'peso' (suavizado
+// con los vecinos y comprimido como en VEGAS, para que la malla no oscile).
+void MuestreoVegas::refinar(const std::vector<double>& peso)
+{
+    const int K = bins_;
+    if (K < 2) return;
+    std::vector<double> d(K);
+    d[0] = (peso[0] + peso[1]) / 2.0;
+    d[K - 1] = (peso[K - 2] + peso[K - 1]) / 2.0;
+    for (int i = 1; i < K - 1; ++i) d[i] = (peso[i - 1] + peso[i] + peso[i + 1]) / 3.0;
+    double total = 0.0;
+    for (double v : d) total += v;
+    if (!(total > 0.0)) return;
+    double suma_r = 0.0;
+    for (double& v : d)
+    {
+        const double x = v / total;
+        v = (x > 0.0 && x < 1.0) ? std::pow((x - 1.0) / std::log(x), alpha_) : (x >= 1.0 ? 1.0 : 0.0);
+        suma_r += v;
+    }
+    if (!(suma_r > 0.0)) return;
+
+    // nuevos bordes: cada bin acumula suma_r / K de peso, interpolando dentro de los viejos
+    const double por_bin = suma_r / K;
+    std::vector<double> nuevos(K + 1);
+    nuevos[0] = bordes_[0];
+    nuevos[K] = bordes_[K];
+    int viejo = 0;
+    double acumulado = 0.0;
+    for (int i = 1; i < K; ++i)
+    {
+        const double objetivo = i * por_bin;
+        while (viejo < K - 1 && acumulado + d[viejo] < objetivo) acumulado += d[viejo++];
+        const double fraccion = (d[viejo] > 0.0) ? (objetivo - acumulado) / d[viejo] : 0.0;
+        nuevos[i] = bordes_[viejo] + std::min(1.0, fraccion) * (bordes_[viejo + 1] - bordes_[viejo]);
+    }
+    bordes_ = nuevos;
+}
+
+ResultadoMonteCarlo MuestreoVegas::estimar(double a, double b, long long n,
+                                           const std::function<double(double)>& f, PhiloxStream& gen)
+{
+    validar(a, b, n, 2LL * iteraciones_);
+    const int K = bins_;
+    if (bordes_.size() != std::size_t(K + 1) || bordes_.front() != a || bordes_.back() != b)
+    {
+        bordes_.resize(K + 1);
+        for (int i = 0; i <= K; ++i) bordes_[i] = a + (b - a) * i / K;
+    }
+
+    // combinacion de las iteraciones pesada por 1 / varianza
+    double suma_pesos = 0.0, suma_valores = 0.0;
+    long long usadas = 0;
+    std::vector<double> peso(K);
+    for (int it = 0; it < iteraciones_; ++it)
+    {
+        const long long m = n / iteraciones_ + (it < n % iteraciones_ ? 1 : 0);
+        std::fill(peso.begin(), peso.end(), 0.0);
+        Acumulador acc;
+        recorrerUniformes(gen, m, [&](double u)
+        {
+            // u -> bin i uniforme y posicion uniforme dentro del bin; J = K (ancho del bin)
+            const double s = u * K;
+            const int i = std::min(int(s), K - 1);
+            const double ancho = bordes_[i + 1] - bordes_[i];
+            const double x = bordes_[i] + (s - i) * ancho;
+            const double valor = f(x) * K * ancho;
+            acc.agregar(valor);
+            peso[i] += valor * valor;
+        });
+        usadas += m;
+
+        const double var_it = acc.varianza() / double(m);
+        if (var_it > 0.0)
+        {
+            suma_pesos += 1.0 / var_it;
+            suma_valores += acc.media / var_it;
+        }
+        else
+        {
+            // f constante sobre la malla: la estimacion es exacta
+            return resultado(acc.media, 0.0, usadas);
+        }
+        refinar(peso);
+    }
+    return resultado(suma_valores / suma_pesos, 1.0 / suma_pesos, usadas);
+}
@@ -0,0 +1,109 @@
+#ifndef REDUCCION_VARIANZA_H
+#define REDUCCION_VARIANZA_H
+
+#include <vector>
+#include <functional>
+#include "montecarlo.h"
+#include "philox.h"
+
+// Estrategia de muestreo para MonteCarloIntegrator::aproximar. Cada estrategia estima
+// la integral de f en [a, b] con n evaluaciones de f y llena todo el ResultadoMonteCarlo,
+// incluida la varianza por muestra (error² · n), que es lo que se compara entre
+// estrategias: a igual error, la muestra necesaria es proporcional a esa varianza.
+class EstrategiaMuestreo
+{
+public:
+    virtual ~EstrategiaMuestreo() = default;
+
+    virtual ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                        const std::function<double(double)>& f, PhiloxStream& gen) = 0;
+};
+
+// Muestreo uniforme simple (la referencia).
+class MuestreoUniforme : public EstrategiaMuestreo
+{
+public:
+    ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                const std::function<double(double)>& f, PhiloxStream& gen) override;
+};
+
+// Estratificado: [a, b] se divide en 'estratos' subintervalos iguales con n / estratos
+// muestras cada uno. Quita la parte de la varianza que viene de la variación de f entre
+// estratos.
+class MuestreoEstratificado : public EstrategiaMuestreo
+{
+private:
+    int estratos_;
+
+public:
+    explicit MuestreoEstratificado(int estratos);
+    ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                const std::function<double(double)>& f, PhiloxStream& gen) override;
+};
+
+// Antitético: pares (x, a + b - x). Para f monótona los dos valores están correlacionados
+// negativamente y el promedio del par varía mucho menos.
+class MuestreoAntitetico : public EstrategiaMuestreo
+{
+public:
+    ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                const std::function<double(double)>& f, PhiloxStream& gen) override;
+};
+
+// Por importancia: x se muestrea con una densidad p en [a, b] dada por el usuario (con su
+// inversa de la función de distribución) y se promedia f(x) / p(x). Conviene que p tenga
+// la forma de |f|; p debe ser positiva donde f no se anula.
+class MuestreoImportancia : public EstrategiaMuestreo
+{
+private:
+    std::function<double(double)> densidad_;  // p(x), normalizada en [a, b]
+    std::function<double(double)> inversa_;   // x(u) con u uniforme en (0, 1)
+
+public:
+    MuestreoImportancia(std::function<double(double)> densidad, std::function<double(double)> inversa);
+    ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                const std::function<double(double)>& f, PhiloxStream& gen) override;
+};
+
+// Variable de control: g parecida a f con integral conocida G en [a, b]. Se estima
+//     I = <f> - beta (<g> - G)
+// con el beta óptimo cov(f, g) / var(g) calculado de las mismas muestras; la varianza
+// baja en el factor 1 - rho², con rho la correlación entre f y g.
+class VariableControl : public EstrategiaMuestreo
+{
+private:
+    std::function<double(double)> g_;
+    double integral_g_;
+
+public:
+    VariableControl(std::function<double(double)> g, double integral_g);
+    ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                const std::function<double(double)>& f, PhiloxStream& gen) override;
+};
+
+// VEGAS (Lepage, 1978) en una dimensión: la densidad de muestreo es constante por tramos
+// sobre una malla de 'bins' intervalos, cada uno con la misma probabilidad. Después de
+// cada iteración los bordes se mueven para que los bins tengan el mismo peso de
+// (f · J)², así que la malla se concentra donde f es grande. Las iteraciones se combinan
+// pesadas por el inverso de su varianza. La malla se conserva entre llamadas (la
+// estrategia sigue aprendiendo) hasta reiniciar() o un intervalo distinto.
+class MuestreoVegas : public EstrategiaMuestreo
+{
+private:
+    int bins_;
+    int iteraciones_;
+    double alpha_;               // amortiguación del refinamiento (entre 0.5 y 2)
+    std::vector<double> bordes_; // bins_ + 1 bordes en [a, b]
+
+    void refinar(const std::vector<double>& peso);
+
+public:
+    explicit MuestreoVegas(int bins = 50, int iteraciones = 5, double alpha = 1.5);
+    ResultadoMonteCarlo estimar(double a, double b, long long n,
+                                const std::function<double(double)>& f, PhiloxStream& gen) override;
+
+    void reiniciar() { bordes_.clear(); }
+    const std::vector<double>& malla() const { return bordes_; }
+};
+
+#endif
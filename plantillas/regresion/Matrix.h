@@ -1,495 +1,680 @@
-#ifndef MATRIX_H // Se mantiene el nombre del include guard, asumiendo que el archivo se llamará Matrix.h
+#ifndef MATRIX_H
 #define MATRIX_H
 
-#include <iostream>    // Para std::ostream, std::cerr, std::endl
+#include <iostream>    // Para std::ostream
 #include <vector>      // Para std::vector
 #include <string>      // Para std::string
 #include <fstream>     // Para std::ofstream
-#include <cmath>       // Para std::abs, std::pow, std::sqrt
+#include <cmath>       // Para std::abs, std::sqrt
 #include <iomanip>     // Para std::fixed, std::setw, std::setprecision
-#include <cassert>     // Para assert (se recomienda <cassert> en lugar de <assert.h>)
-#include <limits>      // Para std::numeric_limits (útil para epsilon si T es float/double)
+#include <limits>      // Para std::numeric_limits
 #include <type_traits> // Para std::is_floating_point_v
+#include <stdexcept>   // Para excepciones estándar como std::out_of_range, std::invalid_argument
+#include <utility>     // Para std::swap
+#include <algorithm>   // Para std::swap_ranges, std::copy
 
-// No usar 'using namespace std;' en archivos de encabezado.
+#include "Vector.h"
+#include "MatrixView.h"
+#include "gemm.h"
+#include "ThreadPool.h"
 
-// Variable global para el conteo de intercambios de filas en Gauss para el determinante.
-// Nota: Para una plantilla, una variable global template-dependiente es compleja.
-// Una alternativa es pasar el contador como referencia en 'gauss' y 'determinante'.
-// Sin embargo, si 'gauss' se llama independientemente, esta es una forma simple.
-int contador_gauss = 0;
+inline int gauss_swap_count = 0;
 
-/* --- Declaración de la clase Matrix --- */
+// Declaraciones adelantadas de las funciones globales para poder declararlas como friend
+// (Necesario si se definen después de la clase Matrix)
+template <class T> class Matrix; // Declaración adelantada de la clase Matrix
+
+template <class U> Matrix<U> gauss_elimination(const Matrix<U>& x);
+template <class U> U determinant(const Matrix<U>& x);
+template <class U> Matrix<U> inverse(const Matrix<U>& x);
+
+
+/* --- Matrix Class Declaration --- */
+// Los elementos se guardan en un único bloque contiguo, fila por fila (row-major):
+// el elemento (r, c) está en data[r * ld_ + c]. Así una matriz grande ocupa una sola
+// reserva de memoria y los recorridos por filas aprovechan la caché.
 template <class T>
-class Matrix // ¡Clase renombrada a 'Matrix'!
+class Matrix
 {
 private:
-    std::vector<std::vector<T>> data; // Almacenamiento interno de los elementos de la matriz.
+    std::vector<T> data;      // Almacenamiento contiguo de los elementos (por filas).
+    std::size_t rows_ = 0;    // Número de filas.
+    std::size_t cols_ = 0;    // Número de columnas.
+    std::size_t ld_ = 0;      // Dimensión principal (leading dimension): distancia entre filas.
+
+    T* row_ptr(std::size_t r) { return data.data() + r * ld_; }
+    const T* row_ptr(std::size_t r) const { return data.data() + r * ld_; }
+
+    // Aplica row_op(i) a cada fila; en paralelo si la matriz supera matrix_parallel_threshold.
+    template <class F>
+    void for_each_row_block(F&& row_op) {
+        const std::size_t grain = std::max<std::size_t>(1, matrix_parallel_threshold / std::max<std::size_t>(1, cols_));
+        if (rows_ * cols_ < matrix_parallel_threshold) {
+            for (std::size_t i = 0; i < rows_; ++i) row_op(i);
+            return;
+        }
+        matrix_thread_pool().parallel_for(0, rows_, grain, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) row_op(i);
+        });
+    }
 
-public:
-    // --- Constructor y Destructor ---
-    Matrix();                                          // Constructor por defecto
-    ~Matrix();                                         // Destructor
-    Matrix(int rows, int cols);                        // Crea una matriz vacía de dimensiones especificadas
-    Matrix(const Matrix<T> & other);                   // Constructor de copia para duplicar una matriz existente
-    Matrix(std::vector<std::vector<T>> elements);     // Inicializa la matriz con un vector de vectores
-    Matrix(int n);                                     // Crea una matriz identidad cuadrada de tamaño n x n
-
-    // --- Operadores de Acceso y Asignación ---
-    Matrix<T> operator = (const Matrix<T> & other);   // Asigna los contenidos de otra matriz
-    T operator()(int r, int c) const;                  // Acceso de solo lectura a un elemento (matriz[r][c])
-    T & operator()(int r, int c);                      // Acceso de lectura/escritura a un elemento (matriz[r][c])
+    // --- Métodos auxiliares privados para operaciones de fila (modificaciones in-place) ---
+    // Estos métodos modifican la matriz directamente.
+    void swap_rows_internal(std::size_t r1, std::size_t r2) {
+        if (r1 >= rows_ || r2 >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango en swap_rows_internal.");
+        }
+        if (r1 != r2) {
+            std::swap_ranges(row_ptr(r1), row_ptr(r1) + cols_, row_ptr(r2));
+        }
+    }
 
-    // --- Métodos de Información y Extracción de Datos ---
-    std::vector<std::vector<T>> get();                 // Retorna una copia de todos los elementos de la matriz
-    std::size_t nrow() const;                          // Retorna el número de filas de la matriz
-    std::size_t ncol() const;                          // Retorna el número de columnas de la matriz
-    std::vector<T> row(int r);                         // Retorna la fila especificada como un vector
-    std::vector<T> col(int c);                         // Retorna la columna especificada como un vector
+    void multiply_row_by_scalar_internal(std::size_t r, T scalar) {
+        if (r >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango en multiply_row_by_scalar_internal.");
+        }
+        T* row = row_ptr(r);
+        for (std::size_t j = 0; j < cols_; ++j) {
+            row[j] *= scalar;
+        }
+    }
 
-    // --- Métodos de Entrada/Salida ---
-    void save(std::string filePath);                   // Guarda el contenido de la matriz en un archivo CSV o similar
+    // Operación: fila_a_modificar_idx -= factor * fila_a_restar_multiplicada_idx
+    void subtract_multiple_of_row_internal(std::size_t row_to_modify_idx, std::size_t row_to_subtract_multiplied_idx, T factor) {
+        if (row_to_modify_idx >= rows_ || row_to_subtract_multiplied_idx >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango en subtract_multiple_of_row_internal.");
+        }
+        T* dst = row_ptr(row_to_modify_idx);
+        const T* src = row_ptr(row_to_subtract_multiplied_idx);
+        for (std::size_t j = 0; j < cols_; ++j) {
+            dst[j] -= factor * src[j];
+        }
+    }
 
-    // --- Implementación de operator << como función amiga inline ---
-    // Esto resuelve el problema de acceso a miembros privados y la declaración de friend.
-    friend std::ostream & operator << (std::ostream & os, const Matrix<T> & a) // Referencia a 'Matrix<T>'
-    {
-        // Define una tolerancia solo si T es un tipo de punto flotante
-        T epsilon = T(); // Inicializa a 0.
-        if constexpr (std::is_floating_point_v<T>) { // C++17 feature
-            epsilon = std::numeric_limits<T>::epsilon() * 100; // Un épsilon más generoso
+    // Método auxiliar para encontrar la fila pivote para una columna específica, comenzando desde una fila dada.
+    std::size_t find_pivot_row_internal(std::size_t col_idx, std::size_t start_row) {
+        if (col_idx >= cols_ || start_row >= rows_) {
+            throw std::out_of_range("Error: Índice de columna o fila de inicio fuera de rango en find_pivot_row_internal.");
         }
 
-        const auto& x = a.data;
+        std::size_t pivot_row = start_row;
+        T pivot_val = data[start_row * ld_ + col_idx];
 
-        os << "[";
-        for (std::size_t i = 0; i < x.size(); ++i) // Usar std::size_t para los bucles
-        {
-            if (i > 0) {
-                os << "," << std::endl << " ";
+        if constexpr (std::is_floating_point_v<T>) {
+            for (std::size_t i = start_row + 1; i < rows_; ++i) {
+                if (std::abs(data[i * ld_ + col_idx]) > std::abs(pivot_val)) {
+                    pivot_val = data[i * ld_ + col_idx];
+                    pivot_row = i;
+                }
             }
-            os << "[";
-            for (std::size_t j = 0; j < x[i].size(); ++j) // Usar std::size_t para los bucles
-            {
-                // Aplica la lógica de tolerancia para tipos flotantes
-                if constexpr (std::is_floating_point_v<T>) {
-                    if (std::abs(x[i][j]) < epsilon) {
-                        os << T(); // Imprime el valor cero para T
-                    } else {
-                        os << x[i][j];
-                    }
-                } else { // Para tipos no flotantes, imprime directamente
-                    os << x[i][j];
+        } else {
+            // Para tipos no flotantes, encuentra el primer pivote no nulo.
+            for (std::size_t i = start_row + 1; i < rows_; ++i) {
+                if (data[i * ld_ + col_idx] != T()) {
+                    pivot_val = data[i * ld_ + col_idx];
+                    pivot_row = i;
+                    break;
                 }
+            }
+        }
+        return pivot_row;
+    }
 
-                if (j < x[i].size() - 1)
-                {
-                    os << ", ";
-                }
+
+public:
+    // --- Declaraciones de funciones amigas para acceso a miembros privados ---
+    template <class U> friend Matrix<U> gauss_elimination(const Matrix<U>& x);
+    template <class U> friend U determinant(const Matrix<U>& x);
+    template <class U> friend Matrix<U> inverse(const Matrix<U>& x);
+
+    // --- Constructores y Destructor ---
+    Matrix() : rows_(0), cols_(0), ld_(0) {} // Constructor por defecto.
+    ~Matrix() = default;                     // Destructor por defecto (std::vector gestiona la memoria).
+
+    // Crea una matriz vacía de dimensiones especificadas.
+    // Inicializa con el valor por defecto de T (ej. 0 para tipos numéricos).
+    Matrix(std::size_t rows, std::size_t cols) : data(rows * cols, T()), rows_(rows), cols_(cols), ld_(cols) {}
+
+    // Constructor de copia.
+    Matrix(const Matrix<T>& other) : data(other.data), rows_(other.rows_), cols_(other.cols_), ld_(other.ld_) {}
+
+    // Constructor por movimiento.
+    Matrix(Matrix<T>&& other) noexcept
+        : data(std::move(other.data)), rows_(other.rows_), cols_(other.cols_), ld_(other.ld_) {
+        other.rows_ = 0; // Deja la fuente en un estado válido y vacío.
+        other.cols_ = 0;
+        other.ld_ = 0;
+    }
+
+    // Inicializa la matriz con un vector de vectores.
+    // (std::initializer_list sería otra opción para inicialización con {}).
+    Matrix(std::vector<std::vector<T>> elements) {
+        rows_ = elements.size();
+        cols_ = (rows_ > 0) ? elements[0].size() : 0;
+        ld_ = cols_;
+        data.reserve(rows_ * cols_);
+        for (std::size_t i = 0; i < rows_; ++i) {
+            // Asegura que todas las filas tengan el mismo número de columnas.
+            if (elements[i].size() != cols_) {
+                throw std::invalid_argument("Error: Todas las filas en el vector de inicialización deben tener el mismo número de columnas.");
+            }
+            for (std::size_t j = 0; j < cols_; ++j) {
+                data.push_back(std::move(elements[i][j]));
             }
-            os << "]";
         }
-        os << "]";
-        return os;
     }
-};
 
-/* --- Declaraciones e Implementaciones de Funciones Globales para Operaciones con Matrices y Vectores --- */
-// Estas funciones operan con la clase 'Matrix<T>'.
+    // Crea una matriz (propietaria) copiando los elementos de una vista.
+    explicit Matrix(const MatrixView<const T>& view)
+        : data(view.size()), rows_(view.rows()), cols_(view.cols()), ld_(view.cols()) {
+        for (std::size_t i = 0; i < rows_; ++i) {
+            for (std::size_t j = 0; j < cols_; ++j) {
+                data[i * ld_ + j] = view(i, j);
+            }
+        }
+    }
 
-// Operador de Flujo para vector<T> (sigue siendo global, no necesita ser friend de Matrix)
-template <class T>
-std::ostream & operator << (std::ostream & os, const std::vector<T> & v) {
-    os << "[";
-    for(std::size_t i = 0; i < v.size(); ++i) { // Usar std::size_t
-        os << v[i];
-        if(i + 1 < v.size()) {
-            os << ", ";
+    // Crea una matriz identidad cuadrada de tamaño n x n.
+    explicit Matrix(std::size_t n) : data(n * n, T()), rows_(n), cols_(n), ld_(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            data[i * ld_ + i] = T(1); // Establece los elementos de la diagonal a 1.
         }
     }
-    os << "]";
-    return os;
-}
 
-/* --- Implementación de la clase Matrix --- */
+    // --- Operadores de Asignación ---
+    Matrix<T>& operator=(const Matrix<T>& other) {
+        if (this != &other) { // Comprobación de auto-asignación.
+            data = other.data;
+            rows_ = other.rows_;
+            cols_ = other.cols_;
+            ld_ = other.ld_;
+        }
+        return *this;
+    }
+
+    // Operador de asignación por movimiento.
+    Matrix<T>& operator=(Matrix<T>&& other) noexcept {
+        if (this != &other) {
+            data = std::move(other.data);
+            rows_ = other.rows_;
+            cols_ = other.cols_;
+            ld_ = other.ld_;
+            other.rows_ = 0; // Deja la fuente en un estado válido y vacío.
+            other.cols_ = 0;
+            other.ld_ = 0;
+        }
+        return *this;
+    }
 
-template <class T>
-Matrix<T>::Matrix(){} // Referencia a 'Matrix<T>'
+    // --- Operadores de Acceso a Elementos ---
+    // Acceso de solo lectura a un elemento (matriz[r][c]).
+    const T& operator()(std::size_t r, std::size_t c) const {
+        if (r >= rows_ || c >= cols_) {
+            throw std::out_of_range("Error: Índice de matriz fuera de rango.");
+        }
+        return data[r * ld_ + c];
+    }
 
-template <class T>
-Matrix<T>::~Matrix(){} // Referencia a 'Matrix<T>'
+    // Acceso de lectura/escritura a un elemento (matriz[r][c]).
+    T& operator()(std::size_t r, std::size_t c) {
+        if (r >= rows_ || c >= cols_) {
+            throw std::out_of_range("Error: Índice de matriz fuera de rango.");
+        }
+        return data[r * ld_ + c];
+    }
 
-template <class T>
-Matrix<T>::Matrix(int rows, int cols) // Referencia a 'Matrix<T>'
-{
-    data.resize(rows);
-    for (int i = 0; i < rows; ++i) {
-        data[i].resize(cols, T()); // Inicializa con el valor por defecto de T (0 para numéricos)
+    // --- Métodos de Información y Extracción de Datos ---
+    // Retorna una copia de todos los elementos de la matriz.
+    std::vector<std::vector<T>> get_data() const {
+        std::vector<std::vector<T>> res(rows_);
+        for (std::size_t i = 0; i < rows_; ++i) {
+            res[i].assign(row_ptr(i), row_ptr(i) + cols_);
+        }
+        return res;
     }
-}
 
-template <class T>
-Matrix<T>::Matrix(const Matrix<T> & other) // Referencia a 'Matrix<T>'
-{
-    data = other.data;
-}
+    std::size_t rows() const { return rows_; } // Obtiene el número de filas.
+    std::size_t cols() const { return cols_; } // Obtiene el número de columnas.
+    std::size_t leading_dim() const { return ld_; } // Distancia (en elementos) entre filas consecutivas.
 
-template <class T>
-Matrix<T>::Matrix(std::vector<std::vector<T>> elements) // Referencia a 'Matrix<T>'
-{
-    data = elements;
-}
+    bool empty() const { return rows_ == 0 || cols_ == 0; } // Comprueba si la matriz está vacía.
 
-template <class T>
-Matrix<T>::Matrix(int n) // Referencia a 'Matrix<T>'
-{
-    data.resize(n);
-    for (int i = 0; i < n; ++i)
-    {
-        data[i].resize(n, T());
-        data[i][i] = T(1); // El valor 1 para el tipo T
+    // Acceso directo al bloque contiguo de elementos (por filas, con paso leading_dim()).
+    T* data_ptr() { return data.data(); }
+    const T* data_ptr() const { return data.data(); }
+
+    // Retorna la fila especificada como un vector (por copia).
+    std::vector<T> get_row(std::size_t r) const {
+        if (r >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango.");
+        }
+        return std::vector<T>(row_ptr(r), row_ptr(r) + cols_);
     }
-}
 
-template <class T>
-Matrix<T> Matrix<T>::operator = (const Matrix<T> & x) // Referencia a 'Matrix<T>'
-{
-    if (this != & x)
-    {
-        data = x.data;
+    // Retorna la columna especificada como un vector (por copia).
+    std::vector<T> get_col(std::size_t c) const {
+        if (c >= cols_) {
+            throw std::out_of_range("Error: Índice de columna fuera de rango.");
+        }
+        std::vector<T> res(rows_);
+        for (std::size_t i = 0; i < rows_; ++i) {
+            res[i] = data[i * ld_ + c];
+        }
+        return res;
     }
-    return *this;
-}
 
-template <class T>
-T Matrix<T>::operator()(int r, int c) const // Referencia a 'Matrix<T>'
-{
-    return data[r][c];
-}
+    // --- Vistas (sin copia) sobre filas, columnas y bloques ---
+    // Vista 1 x cols() de la fila r.
+    MatrixView<T> row_view(std::size_t r) {
+        if (r >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango.");
+        }
+        return MatrixView<T>(row_ptr(r), 1, cols_, ld_);
+    }
+    MatrixView<const T> row_view(std::size_t r) const {
+        if (r >= rows_) {
+            throw std::out_of_range("Error: Índice de fila fuera de rango.");
+        }
+        return MatrixView<const T>(row_ptr(r), 1, cols_, ld_);
+    }
 
-template <class T>
-T & Matrix<T>::operator()(int r, int c) // Referencia a 'Matrix<T>'
-{
-    return data[r][c];
-}
+    // Vista rows() x 1 de la columna c (paso leading_dim() entre elementos).
+    MatrixView<T> col_view(std::size_t c) {
+        if (c >= cols_) {
+            throw std::out_of_range("Error: Índice de columna fuera de rango.");
+        }
+        return MatrixView<T>(data.data() + c, rows_, 1, ld_);
+    }
+    MatrixView<const T> col_view(std::size_t c) const {
+        if (c >= cols_) {
+            throw std::out_of_range("Error: Índice de columna fuera de rango.");
+        }
+        return MatrixView<const T>(data.data() + c, rows_, 1, ld_);
+    }
 
-template <class T>
-std::vector<std::vector<T>> Matrix<T>::get() // Referencia a 'Matrix<T>'
-{
-    return data;
-}
+    // Vista de la submatriz que comienza en (r0, c0) con n_rows x n_cols elementos.
+    MatrixView<T> block(std::size_t r0, std::size_t c0, std::size_t n_rows, std::size_t n_cols) {
+        return view().block(r0, c0, n_rows, n_cols);
+    }
+    MatrixView<const T> block(std::size_t r0, std::size_t c0, std::size_t n_rows, std::size_t n_cols) const {
+        return view().block(r0, c0, n_rows, n_cols);
+    }
 
-template <class T>
-std::size_t Matrix<T>::nrow() const // Referencia a 'Matrix<T>'
-{
-    return data.size();
-}
+    // Vista de la matriz completa.
+    MatrixView<T> view() { return MatrixView<T>(data.data(), rows_, cols_, ld_); }
+    MatrixView<const T> view() const { return MatrixView<const T>(data.data(), rows_, cols_, ld_); }
 
-template <class T>
-std::size_t Matrix<T>::ncol() const // Referencia a 'Matrix<T>'
-{
-    if (data.empty()) {
-        return 0;
-    }
-    return data[0].size();
-}
+    // --- Métodos de Entrada/Salida ---
+    void save(std::string filePath) const {
+        std::ofstream myfile;
+        myfile.open(filePath);
 
-template <class T>
-std::vector<T> Matrix<T>::row(int r) { // Referencia a 'Matrix<T>'
-    return data[r];
-}
+        if (!myfile.is_open()) {
+            throw std::runtime_error("Error: No se pudo abrir el archivo '" + filePath + "' para guardar la matriz.");
+        }
 
-template <class T>
-std::vector<T> Matrix<T>::col(int c) { // Referencia a 'Matrix<T>'
-    std::vector<T> res(data.size());
-    for(std::size_t i = 0; i < data.size(); i++) { // Usar std::size_t
-        res[i] = data[i][c];
+        for (std::size_t i = 0; i < rows_; ++i) {
+            for (std::size_t j = 0; j < cols_; ++j) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    myfile << std::fixed << std::setw(11) << std::setprecision(6) << data[i * ld_ + j];
+                } else {
+                    myfile << data[i * ld_ + j];
+                }
+
+                if (j < cols_ - 1) {
+                    myfile << ",";
+                }
+            }
+            myfile << std::endl;
+        }
+        myfile.close();
     }
-    return res;
-}
 
-template <class T>
-void Matrix<T>::save(std::string filePath) // Referencia a 'Matrix<T>'
-{
-    std::ofstream myfile;
-    myfile.open(filePath);
-    if (!myfile.is_open()) {
-        std::cerr << "Error: No se pudo abrir el archivo '" << filePath << "' para guardar la matriz." << std::endl;
-        return;
-    }
-    for(std::size_t i = 0; i < data.size(); i++) // Usar std::size_t
-    {
-        for (std::size_t j = 0; j < data[i].size(); j++) // Usar std::size_t
-        {
-            if constexpr (std::is_floating_point_v<T>) {
-                myfile << std::fixed << std::setw(11) << std::setprecision(6) << data[i][j];
-            } else {
-                myfile << data[i][j];
+    // --- Operadores de Asignación Compuesta (similar a la STL) ---
+    // Las matrices grandes se reparten por filas entre los hilos de matrix_thread_pool().
+    Matrix<T>& operator+=(const Matrix<T>& other) {
+        if (rows_ != other.rows_ || cols_ != other.cols_) {
+            throw std::invalid_argument("Error: Las matrices deben tener las mismas dimensiones para la suma.");
+        }
+        for_each_row_block([&](std::size_t i) {
+            T* dst = row_ptr(i);
+            const T* src = other.row_ptr(i);
+            for (std::size_t j = 0; j < cols_; ++j) {
+                dst[j] += src[j];
             }
+        });
+        return *this;
+    }
 
-            if(j < data[i].size() - 1)
-            {
-                myfile << ",";
+    Matrix<T>& operator-=(const Matrix<T>& other) {
+        if (rows_ != other.rows_ || cols_ != other.cols_) {
+            throw std::invalid_argument("Error: Las matrices deben tener las mismas dimensiones para la resta.");
+        }
+        for_each_row_block([&](std::size_t i) {
+            T* dst = row_ptr(i);
+            const T* src = other.row_ptr(i);
+            for (std::size_t j = 0; j < cols_; ++j) {
+                dst[j] -= src[j];
             }
+        });
+        return *this;
+    }
+
+    Matrix<T>& operator*=(T scalar) {
+        for (std::size_t i = 0; i < rows_; ++i) {
+            multiply_row_by_scalar_internal(i, scalar);
         }
-        myfile << std::endl;
+        return *this;
     }
-    myfile.close();
-}
 
-/* --- Implementación de funciones globales (operadores y utilidades) --- */
+    // --- Función amiga para el operador de salida << ---
+    friend std::ostream& operator<<(std::ostream& os, const Matrix<T>& a) {
+        // Define un épsilon solo si T es un tipo de punto flotante.
+        T epsilon = T(); // Inicializa a 0.
+        if constexpr (std::is_floating_point_v<T>) { // Característica de C++17.
+            epsilon = std::numeric_limits<T>::epsilon() * 100; // Un épsilon más generoso.
+        }
 
-template <class T>
-Matrix<T> operator + (const Matrix<T> & a1, const Matrix<T> & b1) // Referencia a 'Matrix<T>'
-{
-    assert(a1.nrow() == b1.nrow() && a1.ncol() == b1.ncol());
-    Matrix<T> suma(a1.nrow(), a1.ncol()); // Referencia a 'Matrix<T>'
-    for (std::size_t i = 0; i < a1.nrow(); ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < a1.ncol(); ++j) { // Usar std::size_t
-            suma(i,j) = a1(i,j) + b1(i,j);
+        os << "[";
+        for (std::size_t i = 0; i < a.rows(); ++i) {
+            if (i > 0) {
+                os << "," << std::endl << " ";
+            }
+            os << "[";
+            for (std::size_t j = 0; j < a.cols(); ++j) {
+                // Aplica la lógica de tolerancia para tipos flotantes.
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (std::abs(a(i, j)) < epsilon) {
+                        os << T(); // Imprime el valor cero para el tipo T.
+                    } else {
+                        os << a(i, j);
+                    }
+                } else { // Para tipos no flotantes, imprime directamente.
+                    os << a(i, j);
+                }
+
+                if (j < a.cols() - 1) {
+                    os << ", ";
+                }
+            }
+            os << "]";
         }
+        os << "]";
+        return os;
     }
-    return suma;
-}
+};
+
+/* --- Global Functions for Matrix and Vector Operations --- */
 
+// Operador de salida para std::vector<T> (permanece global, no necesita ser amiga de Matrix).
+// Este operador es para std::vector, no tu clase Vector. Si tu clase Vector tiene su propio <<,
+// este es solo para uso general de std::vector.
 template <class T>
-Matrix<T> operator - (const Matrix<T> & a1, const Matrix<T> & b1) // Referencia a 'Matrix<T>'
-{
-    assert(a1.nrow() == b1.nrow() && a1.ncol() == b1.ncol());
-    Matrix<T> resta(a1.nrow(), a1.ncol()); // Referencia a 'Matrix<T>'
-    for (std::size_t i = 0; i < a1.nrow(); ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < a1.ncol(); ++j) { // Usar std::size_t
-            resta(i,j) = a1(i,j) - b1(i,j);
+std::ostream& operator<<(std::ostream& os, const std::vector<T>& v) {
+    os << "[";
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        os << v[i];
+        if (i + 1 < v.size()) {
+            os << ", ";
         }
     }
-    return resta;
+    os << "]";
+    return os;
 }
 
+// --- Operadores Binarios (funciones no miembro para permitir conversiones implícitas en ambos lados) ---
+
 template <class T>
-Matrix<T> operator * (T scalar, const Matrix<T> & m) // Referencia a 'Matrix<T>'
-{
-    Matrix<T> producto(m.nrow(), m.ncol()); // Referencia a 'Matrix<T>'
-    for (std::size_t i = 0; i < m.nrow(); ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < m.ncol(); ++j) { // Usar std::size_t
-            producto(i,j) = scalar * m(i,j);
-        }
+Matrix<T> operator+(const Matrix<T>& a1, const Matrix<T>& b1) {
+    if (a1.rows() != b1.rows() || a1.cols() != b1.cols()) {
+        throw std::invalid_argument("Error: Las matrices deben tener las mismas dimensiones para la suma.");
     }
-    return producto;
+    Matrix<T> sum_matrix = a1; // Copia para usar +=.
+    sum_matrix += b1;
+    return sum_matrix;
 }
 
 template <class T>
-std::vector<T> operator * (const Matrix<T> & a, const std::vector<T> &x) // Referencia a 'Matrix<T>'
-{
-    assert(a.ncol() == x.size());
-
-    std::vector<T> resultado(a.nrow(), T());
-
-    for(std::size_t i = 0; i < a.nrow(); ++i) { // Usar std::size_t
-        for(std::size_t j = 0; j < a.ncol(); ++j) { // Usar std::size_t
-            resultado[i] = resultado[i] + (a(i, j) * x[j]);
-        }
+Matrix<T> operator-(const Matrix<T>& a1, const Matrix<T>& b1) {
+    if (a1.rows() != b1.rows() || a1.cols() != b1.cols()) {
+        throw std::invalid_argument("Error: Las matrices deben tener las mismas dimensiones para la resta.");
     }
-    return resultado;
+    Matrix<T> subtract_matrix = a1; // Copia para usar -=.
+    subtract_matrix -= b1;
+    return subtract_matrix;
 }
 
 template <class T>
-std::vector<T> operator * (const std::vector<T> & v, const Matrix<T> & m) // Referencia a 'Matrix<T>'
-{
-    assert(v.size() == m.nrow());
-
-    std::vector<T> resultado(m.ncol(), T());
-
-    for (std::size_t j = 0; j < m.ncol(); ++j) { // Usar std::size_t
-        for (std::size_t k = 0; k < v.size(); ++k) { // Usar std::size_t
-            resultado[j] = resultado[j] + (v[k] * m(k, j));
-        }
-    }
-    return resultado;
+Matrix<T> operator*(T scalar, const Matrix<T>& m) {
+    Matrix<T> product_matrix = m; // Copia para usar *=.
+    product_matrix *= scalar;
+    return product_matrix;
 }
 
 template <class T>
-Matrix<T> operator * (const Matrix<T> & a1, const Matrix<T> & b1) // Referencia a 'Matrix<T>'
-{
-    assert(a1.ncol() == b1.nrow());
-    Matrix<T> producto(a1.nrow(), b1.ncol()); // Referencia a 'Matrix<T>'
-    for (std::size_t i = 0; i < a1.nrow(); ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < b1.ncol(); ++j) { // Usar std::size_t
-            for (std::size_t k = 0; k < a1.ncol(); ++k) { // Usar std::size_t
-                producto(i,j) = producto(i,j) + (a1(i,k) * b1(k,j));
-            }
-        }
-    }
-    return producto;
+Matrix<T> operator*(const Matrix<T>& m, T scalar) {
+    return scalar * m; // Reutiliza el operador anterior.
 }
 
+// ¡Operador de multiplicación Matriz * Vector<T> (tu clase Vector)!
 template <class T>
-std::vector<T> operator + (const std::vector<T> & v1, const std::vector<T> & v2) {
-    assert(v1.size() == v2.size());
-    std::vector<T> res(v1.size());
-    for(std::size_t i = 0; i < v1.size(); ++i) { // Usar std::size_t
-        res[i] = v1[i] + v2[i];
+Vector<T> operator*(const Matrix<T>& a, const Vector<T>& x) {
+    if (a.cols() != x.size()) {
+        throw std::invalid_argument("Error: Las dimensiones de la matriz y el vector no son compatibles para la multiplicación.");
     }
-    return res;
+    Vector<T> result_vector(a.rows(), T()); // Construir tu clase Vector
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        for (std::size_t j = 0; j < a.cols(); ++j) {
+            result_vector[i] += (a(i, j) * x[j]);
+        }
+    }
+    return result_vector;
 }
 
+// ¡Operador de multiplicación Vector<T> (tu clase Vector) * Matriz!
 template <class T>
-std::vector<T> operator - (const std::vector<T> & v1, const std::vector<T> & v2) {
-    assert(v1.size() == v2.size());
-    std::vector<T> res(v1.size());
-    for(std::size_t i = 0; i < v1.size(); ++i) { // Usar std::size_t
-        res[i] = v1[i] - v2[i];
+Vector<T> operator*(const Vector<T>& v, const Matrix<T>& m) {
+    if (v.size() != m.rows()) {
+        throw std::invalid_argument("Error: Las dimensiones del vector y la matriz no son compatibles para la multiplicación.");
+    }
+    Vector<T> result_vector(m.cols(), T()); // Construir tu clase Vector
+    for (std::size_t j = 0; j < m.cols(); ++j) {
+        for (std::size_t k = 0; k < v.size(); ++k) {
+            result_vector[j] += (v[k] * m(k, j));
+        }
     }
-    return res;
+    return result_vector;
 }
 
 template <class T>
-T norm2(const std::vector<T> & v) {
-    T res = T(); // Inicializa a 0 para el tipo T
-    for(std::size_t i = 0; i < v.size(); ++i) { res = res + (v[i] * v[i]); } // Usar std::size_t
-    if constexpr (std::is_floating_point_v<T>) {
-        return std::sqrt(res);
-    } else {
-        return static_cast<T>(std::sqrt(static_cast<double>(res)));
+Matrix<T> operator*(const Matrix<T>& a1, const Matrix<T>& b1) {
+    if (a1.cols() != b1.rows()) {
+        throw std::invalid_argument("Error: Las dimensiones de las matrices no son compatibles para la multiplicación.");
     }
+    Matrix<T> product_matrix(a1.rows(), b1.cols());
+    // Producto por bloques con micro-kernel vectorizado (ver gemm.h).
+    gemm(T(1), a1.view(), b1.view(), product_matrix.view());
+    return product_matrix;
 }
 
-
-/* --- Implementación de Funciones Utilitarias de Álgebra Lineal --- */
+/* --- Funciones Utilitarias de Álgebra Lineal --- */
 
 template <class T>
-Matrix<T> transpuesta(const Matrix<T> & M) // Referencia a 'Matrix<T>'
-{
-    std::size_t filas = M.nrow(); // Usar std::size_t
-    std::size_t columnas = M.ncol(); // Usar std::size_t
-
-    Matrix<T> m_transpuesta(columnas, filas); // Referencia a 'Matrix<T>'
-
-    for (std::size_t i = 0; i < filas; ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < columnas; ++j) { // Usar std::size_t
-            m_transpuesta(j,i) = M(i,j);
+Matrix<T> transpose(const Matrix<T>& M) {
+    std::size_t num_rows = M.rows();
+    std::size_t num_cols = M.cols();
+
+    Matrix<T> transposed_matrix(num_cols, num_rows);
+    MatrixView<const T> src = M.view();
+    MatrixView<T> dst = transposed_matrix.view();
+
+    // Se transpone por teselas de tile x tile para que lectura y escritura queden en caché;
+    // las franjas de filas de M se reparten entre los hilos cuando la matriz es grande.
+    constexpr std::size_t tile = 32;
+    auto transpose_rows = [&](std::size_t first_row, std::size_t last_row) {
+        for (std::size_t i0 = first_row; i0 < last_row; i0 += tile) {
+            const std::size_t i1 = std::min(i0 + tile, last_row);
+            for (std::size_t j0 = 0; j0 < num_cols; j0 += tile) {
+                const std::size_t j1 = std::min(j0 + tile, num_cols);
+                for (std::size_t i = i0; i < i1; ++i) {
+                    for (std::size_t j = j0; j < j1; ++j) {
+                        dst(j, i) = src(i, j);
+                    }
+                }
+            }
         }
+    };
+
+    if (num_rows * num_cols < matrix_parallel_threshold) {
+        transpose_rows(0, num_rows);
+    } else {
+        matrix_thread_pool().parallel_for(0, num_rows, 4 * tile, transpose_rows);
     }
-    return m_transpuesta;
+    return transposed_matrix;
 }
 
+// Refactorización de eliminación Gaussiana: ahora utiliza métodos auxiliares privados.
 template <class T>
-Matrix<T> gauss(const Matrix<T> & x) // Referencia a 'Matrix<T>'
-{
-    Matrix<T> m_gauss = x; // Referencia a 'Matrix<T>'
+Matrix<T> gauss_elimination(const Matrix<T>& x) {
+    Matrix<T> result_matrix = x; // Trabaja sobre una copia.
+    gauss_swap_count = 0;      // Reinicia el contador global de intercambios.
 
-    contador_gauss = 0; // Reinicio de la variable global
+    if (result_matrix.empty()) return result_matrix;
 
-    for (std::size_t i = 0; i < m_gauss.nrow(); ++i) { // Usar std::size_t
-        T pivote_val = m_gauss(i, i);
-        std::size_t fila_pivote_maximo = i; // Usar std::size_t
+    std::size_t num_rows = result_matrix.rows();
+    std::size_t num_cols = result_matrix.cols();
 
-        if constexpr (std::is_floating_point_v<T>) {
-            for (std::size_t j = i + 1; j < m_gauss.nrow(); ++j) { // Usar std::size_t
-                if (std::abs(m_gauss(j, i)) > std::abs(pivote_val)) {
-                    pivote_val = m_gauss(j, i);
-                    fila_pivote_maximo = j;
-                }
-            }
-        } else {
-            for (std::size_t j = i + 1; j < m_gauss.nrow(); ++j) { // Usar std::size_t
-                if (m_gauss(j, i) != T()) {
-                    pivote_val = m_gauss(j, i);
-                    fila_pivote_maximo = j;
-                    break;
-                }
-            }
-        }
+    // Itera sobre cada columna (o posición de pivote).
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        // 1. Encuentra el pivote e intercambia filas si es necesario.
+        std::size_t pivot_row_idx = result_matrix.find_pivot_row_internal(i, i);
 
-        if (fila_pivote_maximo != i) {
-            for (std::size_t j = 0; j < m_gauss.ncol(); ++j) { // Usar std::size_t
-                T temp = m_gauss(i, j);
-                m_gauss(i, j) = m_gauss(fila_pivote_maximo, j);
-                m_gauss(fila_pivote_maximo, j) = temp;
-            }
-            contador_gauss += 1;
+        if (pivot_row_idx != i) {
+            result_matrix.swap_rows_internal(i, pivot_row_idx);
+            gauss_swap_count += 1;
         }
 
-        if (m_gauss(i, i) == T()) {
-            std::cerr << "Error: Pivote cero o muy cercano a cero durante la eliminación gaussiana. La matriz puede ser singular." << std::endl;
+        // Obtiene el valor del pivote después del posible intercambio.
+        T pivot_value = result_matrix(i, i);
+
+        // Define épsilon para comparaciones de punto flotante.
+        T epsilon = T();
+        if constexpr (std::is_floating_point_v<T>) {
+            epsilon = std::numeric_limits<T>::epsilon() * 100;
         }
 
-        for (std::size_t j = 0; j < m_gauss.nrow(); ++j) { // Usar std::size_t
-            if (i != j) {
-                if (m_gauss(i,i) == T()) continue;
+        // Si el pivote es cero o muy cercano a cero, la matriz podría ser singular.
+        if (pivot_value == T() || (std::is_floating_point_v<T> && std::abs(pivot_value) < epsilon)) {
+            // Para la eliminación Gaussiana (forma escalonada por filas), simplemente
+            // pasamos a la siguiente columna/pivote. Una matriz singular resultará en
+            // un cero en la diagonal en esta etapa.
+            continue;
+        }
 
-                T factor = m_gauss(j, i) / m_gauss(i, i);
-                for (std::size_t k = 0; k < m_gauss.ncol(); ++k) { // Usar std::size_t
-                    m_gauss(j, k) = m_gauss(j, k) - (factor * m_gauss(i, k));
-                }
+        // 2. Elimina los elementos debajo del pivote (eliminación hacia adelante).
+        // Cada fila se actualiza de forma independiente, así que las filas se reparten
+        // entre los hilos cuando el bloque restante es grande.
+        auto eliminate_rows = [&](std::size_t first, std::size_t last) {
+            for (std::size_t j = first; j < last; ++j) {
+                T factor = result_matrix(j, i) / pivot_value;
+                result_matrix.subtract_multiple_of_row_internal(j, i, factor);
             }
+        };
+        const std::size_t remaining_rows = num_rows - (i + 1);
+        if (remaining_rows * num_cols < matrix_parallel_threshold) {
+            eliminate_rows(i + 1, num_rows);
+        } else {
+            const std::size_t grain = std::max<std::size_t>(1, matrix_parallel_threshold / (4 * num_cols));
+            matrix_thread_pool().parallel_for(i + 1, num_rows, grain, eliminate_rows);
         }
     }
-    return m_gauss;
+    return result_matrix;
 }
 
 template <class T>
-T determinante(const Matrix<T> & x) // Referencia a 'Matrix<T>'
-{
-    assert(x.nrow() == x.ncol());
+T determinant(const Matrix<T>& x) {
+    if (x.rows() != x.cols()) {
+        throw std::invalid_argument("Error: El determinante solo se puede calcular para matrices cuadradas.");
+    }
+    if (x.empty()) return T(0); // El determinante de una matriz vacía es 0 (o indefinido según la convención).
 
-    Matrix<T> m_reducida = gauss(x); // Referencia a 'Matrix<T>'
-    T det_val = T(1);
+    Matrix<T> reduced_matrix = gauss_elimination(x); // Utiliza la eliminación Gaussiana refactorizada.
+    T det_value = T(1);
 
-    if ((contador_gauss % 2) != 0) {
-        det_val = det_val * T(-1);
+    // Aplica el cambio de signo basado en los intercambios de filas.
+    if ((gauss_swap_count % 2) != 0) {
+        det_value = det_value * T(-1);
     }
 
-    for (std::size_t i = 0; i < x.nrow(); ++i) { // Usar std::size_t
-        det_val = det_val * m_reducida(i, i);
+    // Multiplica los elementos de la diagonal.
+    for (std::size_t i = 0; i < x.rows(); ++i) {
+        det_value = det_value * reduced_matrix(i, i);
     }
-    return det_val;
+    return det_value;
 }
 
+// Refactorización de la inversa (utilizando eliminación de Gauss-Jordan).
 template <class T>
-Matrix<T> inversa(const Matrix<T> & x) // Referencia a 'Matrix<T>'
-{
-    assert(x.nrow() == x.ncol());
+Matrix<T> inverse(const Matrix<T>& x) {
+    if (x.rows() != x.cols()) {
+        throw std::invalid_argument("Error: La inversa solo se puede calcular para matrices cuadradas.");
+    }
+    if (x.empty()) return Matrix<T>(); // Retorna una matriz vacía si la entrada es vacía.
 
-    Matrix<T> m_extendida(x.nrow(), x.ncol() * 2); // Referencia a 'Matrix<T>'
+    std::size_t n = x.rows();
+    Matrix<T> augmented_matrix(n, n * 2); // Crea la matriz aumentada [A | I].
 
-    for (std::size_t i = 0; i < x.nrow(); ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < x.ncol(); ++j) { // Usar std::size_t
-            m_extendida(i, j) = x(i, j);
+    // Copia la matriz original a la parte izquierda y la matriz identidad a la parte derecha.
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            augmented_matrix(i, j) = x(i, j);
         }
+        augmented_matrix(i, i + n) = T(1); // Establece la parte de la identidad.
     }
 
-    for (std::size_t i = 0; i < x.nrow(); ++i) { // Usar std::size_t
-        m_extendida(i, i + x.ncol()) = T(1);
+    // Aplica la eliminación de Gauss-Jordan.
+    T epsilon = T();
+    if constexpr (std::is_floating_point_v<T>) {
+        epsilon = std::numeric_limits<T>::epsilon() * 100;
     }
 
-    m_extendida = gauss(m_extendida);
+    // Itera sobre cada fila para crear pivotes y eliminar elementos.
+    for (std::size_t i = 0; i < n; ++i) {
+        // 1. Encuentra el pivote e intercambia filas.
+        std::size_t pivot_row_idx = augmented_matrix.find_pivot_row_internal(i, i);
 
-    for (std::size_t i = 0; i < x.nrow(); ++i) { // Usar std::size_t
-        T factor = m_extendida(i, i);
-        if constexpr (std::is_floating_point_v<T>) {
-            if (std::abs(factor) < std::numeric_limits<T>::epsilon() * 100) {
-                std::cerr << "Error: Matriz singular (pivote cero o muy cercano). No se puede calcular la inversa." << std::endl;
-                return Matrix<T>(0,0); // Retorna una matriz vacía si es singular
-            }
-        } else {
-            if (factor == T()) {
-                std::cerr << "Error: Matriz singular. No se puede calcular la inversa." << std::endl;
-                return Matrix<T>(0,0); // Retorna una matriz vacía si es singular
-            }
+        if (pivot_row_idx != i) {
+            augmented_matrix.swap_rows_internal(i, pivot_row_idx);
+        }
+
+        T pivot_value = augmented_matrix(i, i);
+
+        // Comprueba si la matriz es singular (pivote es cero o muy cercano a cero).
+        if (pivot_value == T() || (std::is_floating_point_v<T> && std::abs(pivot_value) < epsilon)) {
+            throw std::runtime_error("Error: La matriz es singular o casi singular. No se puede calcular la inversa.");
         }
 
-        for (std::size_t j = 0; j < m_extendida.ncol(); ++j) { // Usar std::size_t
-            m_extendida(i, j) = m_extendida(i, j) / factor;
+        // 2. Normaliza la fila del pivote para que el elemento pivote se convierta en 1.
+        augmented_matrix.multiply_row_by_scalar_internal(i, T(1) / pivot_value);
+
+        // 3. Elimina los elementos en la columna actual, tanto por encima como por debajo del pivote.
+        for (std::size_t j = 0; j < n; ++j) {
+            if (i != j) { // No elimina el propio pivote.
+                T factor = augmented_matrix(j, i); // El pivote ahora es 1.
+                augmented_matrix.subtract_multiple_of_row_internal(j, i, factor);
+            }
         }
     }
 
-    Matrix<T> m_inversa(x.nrow(), x.ncol()); // Referencia a 'Matrix<T>'
-    for (std::size_t i = 0; i < x.nrow(); ++i) { // Usar std::size_t
-        for (std::size_t j = 0; j < x.ncol(); ++j) { // Usar std::size_t
-            m_inversa(i, j) = m_extendida(i, j + x.ncol());
+    // La parte izquierda de la matriz aumentada ahora es la identidad.
+    // La parte derecha es la matriz inversa.
+    Matrix<T> inverted_matrix(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            inverted_matrix(i, j) = augmented_matrix(i, j + n);
         }
     }
-    return m_inversa;
+    return inverted_matrix;
 }
 
-#endif
+#endif
\ No newline at end of file
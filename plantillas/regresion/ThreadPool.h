@@ -0,0 +1,229 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>             // Para std::vector
+#include <deque>              // Para std::deque (cola de tareas de cada hilo)
+#include <functional>         // Para std::function
+#include <thread>             // Para std::thread
+#include <mutex>              // Para std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // Para std::condition_variable
+#include <atomic>             // Para std::atomic
+#include <memory>             // Para std::unique_ptr
+#include <exception>          // Para std::exception_ptr
+#include <algorithm>          // Para std::min, std::max
+#include <cstddef>            // Para std::size_t
+
+/* --- ThreadPool Class Declaration --- */
+// Conjunto de hilos con robo de trabajo (work stealing) compartido por las operaciones
+// de Matrix. Cada hilo tiene su propia cola: toma tareas del frente de la suya y, cuando
+// se queda sin trabajo, roba del final de la cola de otro hilo. Así los bloques de
+// distinto costo (por ejemplo, los bordes de un producto) se reparten solos.
+//
+// El hilo que llama a parallel_for también trabaja (usa la cola 0) y espera a que
+// terminen todos los trozos antes de retornar.
+//
+// Modo determinista: los trozos se asignan a los hilos de forma fija (round-robin) y
+// no hay robo, de modo que el mismo trozo lo ejecuta siempre el mismo hilo. Los valores
+// numéricos no dependen del modo: todas las operaciones de Matrix reparten el trabajo
+// por elementos de salida, nunca dividen una suma entre hilos.
+class ThreadPool
+{
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::atomic<std::size_t> size{0};
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_; // queues_[0] pertenece al hilo que llama.
+    std::vector<std::thread> workers_;               // Hilos auxiliares (usan queues_[1..]).
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<std::size_t> queued_{0};             // Tareas pendientes en todas las colas.
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> deterministic_{false};
+    std::mutex submit_mutex_;                        // Serializa llamadas desde hilos externos.
+
+    // Indica si el hilo actual ya está ejecutando una tarea del pool.
+    // Las llamadas anidadas a parallel_for se ejecutan en serie para evitar bloqueos.
+    static bool& inside_task() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    bool try_pop(std::size_t q, std::function<void()>& task) {
+        WorkQueue& queue = *queues_[q];
+        if (queue.size.load() == 0) return false;
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queue.size.fetch_sub(1);
+        queued_.fetch_sub(1);
+        return true;
+    }
+
+    bool try_steal(std::size_t thief, std::function<void()>& task) {
+        if (deterministic_.load()) return false;
+        const std::size_t nq = queues_.size();
+        for (std::size_t offset = 1; offset < nq; ++offset) {
+            WorkQueue& victim = *queues_[(thief + offset) % nq];
+            if (victim.size.load() == 0) continue;
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.empty()) continue;
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            victim.size.fetch_sub(1);
+            queued_.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    bool has_work_for(std::size_t q) const {
+        return deterministic_.load() ? queues_[q]->size.load() > 0 : queued_.load() > 0;
+    }
+
+    void worker_loop(std::size_t q) {
+        inside_task() = true;
+        std::function<void()> task;
+        while (true) {
+            if (try_pop(q, task) || try_steal(q, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.wait(lock, [&] { return stop_.load() || has_work_for(q); });
+            if (stop_.load()) return;
+        }
+    }
+
+public:
+    // Crea un pool con 'num_threads' hilos en total (contando al que llama).
+    // Con num_threads <= 1 todo se ejecuta en serie en el hilo que llama.
+    explicit ThreadPool(std::size_t num_threads) {
+        num_threads = std::max<std::size_t>(1, num_threads);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            queues_.push_back(std::make_unique<WorkQueue>());
+        }
+        for (std::size_t i = 1; i < num_threads; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_.store(true);
+        }
+        sleep_cv_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t num_threads() const { return queues_.size(); }
+
+    void set_deterministic(bool value) { deterministic_.store(value); }
+    bool deterministic() const { return deterministic_.load(); }
+
+    // Ejecuta body(lo, hi) sobre trozos consecutivos de [begin, end) de tamaño 'grain'
+    // (el último puede ser menor). Retorna cuando todos los trozos han terminado.
+    // Si algún trozo lanza una excepción, se relanza la primera en el hilo que llama.
+    template <class F>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, F&& body) {
+        if (end <= begin) return;
+        grain = std::max<std::size_t>(1, grain);
+        const std::size_t n_chunks = (end - begin + grain - 1) / grain;
+
+        if (workers_.empty() || n_chunks == 1 || inside_task()) {
+            body(begin, end);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+        std::atomic<std::size_t> remaining(n_chunks);
+        std::exception_ptr first_error;
+        std::mutex error_mutex;
+
+        const std::size_t nq = queues_.size();
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            for (std::size_t c = 0; c < n_chunks; ++c) {
+                const std::size_t lo = begin + c * grain;
+                const std::size_t hi = std::min(end, lo + grain);
+                WorkQueue& queue = *queues_[c % nq];
+                std::lock_guard<std::mutex> queue_lock(queue.mutex);
+                queue.tasks.emplace_back([&, lo, hi] {
+                    try {
+                        body(lo, hi);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> error_lock(error_mutex);
+                        if (!first_error) first_error = std::current_exception();
+                    }
+                    remaining.fetch_sub(1);
+                });
+                queue.size.fetch_add(1);
+                queued_.fetch_add(1);
+            }
+        }
+        sleep_cv_.notify_all();
+
+        // El hilo que llama también procesa trozos mientras espera.
+        inside_task() = true;
+        std::function<void()> task;
+        while (remaining.load() > 0) {
+            if (try_pop(0, task) || try_steal(0, task)) {
+                task();
+                task = nullptr;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        inside_task() = false;
+
+        if (first_error) std::rethrow_exception(first_error);
+    }
+};
+
+/* --- Pool global de la biblioteca de matrices --- */
+
+// Número de hilos por defecto: todos los núcleos disponibles.
+inline std::size_t default_matrix_num_threads() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// El pool se crea en la inicialización del static local, que C++11 garantiza que ocurre
+// una sola vez aunque varios hilos lleguen a la vez.
+inline std::unique_ptr<ThreadPool>& matrix_thread_pool_instance() {
+    static std::unique_ptr<ThreadPool> pool = std::make_unique<ThreadPool>(default_matrix_num_threads());
+    return pool;
+}
+
+// Pool compartido por todas las operaciones de Matrix (se crea al primer uso).
+inline ThreadPool& matrix_thread_pool() {
+    return *matrix_thread_pool_instance();
+}
+
+// Cambia el número de hilos del pool global (1 = ejecución en serie).
+// No debe llamarse mientras otra operación de Matrix está en curso.
+inline void set_matrix_num_threads(std::size_t num_threads) {
+    const bool deterministic = matrix_thread_pool_instance()->deterministic();
+    matrix_thread_pool_instance() = std::make_unique<ThreadPool>(num_threads);
+    matrix_thread_pool_instance()->set_deterministic(deterministic);
+}
+
+inline std::size_t matrix_num_threads() { return matrix_thread_pool().num_threads(); }
+
+// Activa/desactiva el modo determinista (reparto fijo de trozos, sin robo).
+inline void set_matrix_deterministic(bool value) { matrix_thread_pool().set_deterministic(value); }
+
+// Por debajo de este número de elementos las operaciones elemento a elemento no se paralelizan.
+inline constexpr std::size_t matrix_parallel_threshold = 1 << 16;
+
+#endif
@@ -4,21 +4,27 @@
 #include <iostream>  // Para std::cerr, std::endl
 #include <vector>    // Para std::vector
 #include <string>    // Para std::string (rutas de archivo, tipo de regresion)
-#include <fstream>   // Para std::ifstream (lectura de archivos)
-#include <sstream>   // Para std::istringstream (parsing de líneas)
+#include <stdexcept> // Para std::runtime_error (errores del lector de datos)
 #include "Matrix.h"
+#include "data_loader.h"
+#include "Cholesky.h"
+#include "QR.h"
+
+// Muestra los coeficientes de una regresión (compartido por las clases de regresión).
+void print_regression_coefficients(const std::vector<double>& coefficients, const std::string& regression_type);
 
 // Clase para realizar regresión lineal múltiple usando Mínimos Cuadrados Ordinarios (OLS).
 // Carga datos desde un archivo, calcula los coeficientes y puede mostrarlos.
 class linear_regression
 {
 private:
-    std::vector<std::vector<double>> v_dataset; // Datos de entrada: { {x1, x2, ..., y}, ... }
+    DataColumns m_data;                         // Datos de entrada por columnas: x1, x2, ..., y
     std::vector<double> m_coefficients;         // Coeficientes calculados (beta_0, beta_1, ...)
     std::string m_regression_type;              // Tipo de regresión ("lineal", "cuadratica", etc.)
+    std::string m_solver;                       // Método de mínimos cuadrados ("qr", "qr_pivoting", "cholesky")
 
-    // Método privado para cargar datos desde un archivo.
-    // Retorna true si la carga fue exitosa, false en caso contrario.
+    // Método privado para cargar datos desde un archivo (mapeado en memoria y convertido en
+    // paralelo por load_data_columns). Retorna true si la carga fue exitosa, false en caso contrario.
     bool load_data_from_file(const std::string& file_path);
 
     // Método privado que contiene la lógica para calcular la regresión lineal.
@@ -39,12 +45,58 @@ public:
     // Carga los datos del archivo y realiza el cálculo de la regresión.
     // 'file_path': Ruta al archivo de datos.
     // 'regression_type': Cadena que indica el tipo de regresión (ej. "linear").
-    explicit linear_regression(const std::string& file_path, const std::string& regression_type = "linear");
+    // 'solver': Método para resolver mínimos cuadrados:
+    //   "qr"          QR de Householder sobre X (por defecto, el más preciso).
+    //   "qr_pivoting" QR con pivoteo de columnas (predictores colineales).
+    //   "cholesky"    Ecuaciones normales XᵀX con Cholesky/LDLᵀ (el más rápido, pero
+    //                 eleva al cuadrado el número de condición de X).
+    explicit linear_regression(const std::string& file_path, const std::string& regression_type = "linear",
+                               const std::string& solver = "qr");
 
     // Muestra los coeficientes calculados de la regresión.
     void show() const; // 'const' porque no modifica el estado del objeto
 };
 
+// Regresión lineal en modo streaming, para datos que no caben en memoria.
+// Lee las filas una a una y las acumula en el factor QR de [X | y] (QRAccumulator), sin
+// guardar el dataset: la memoria es O(p²) sin importar el número de filas. Se pueden
+// añadir más archivos o lotes a un ajuste existente sin reprocesar las filas anteriores.
+class streaming_linear_regression
+{
+private:
+    QRAccumulator<double> m_accumulator;  // Factor triangular de [1 X | y].
+    std::size_t m_num_predictores = 0;
+    bool m_initialized = false;           // true después de la primera fila (fija el número de columnas).
+    std::vector<double> m_row;            // Fila [1, x1, ..., xp] reutilizada en cada add_row.
+
+public:
+    streaming_linear_regression();
+    ~streaming_linear_regression();
+
+    // Crea el ajuste y añade todas las filas del archivo.
+    explicit streaming_linear_regression(const std::string& file_path);
+
+    // Añade una fila {x1, ..., xp, y}. Todas las filas deben tener el mismo largo.
+    bool add_row(const std::vector<double>& row);
+
+    // Añade un lote de filas {x1, ..., xp, y}.
+    bool add_batch(const std::vector<std::vector<double>>& batch);
+
+    // Recorre el archivo (mapeado en memoria) fila por fila y añade cada una, sin guardar los datos.
+    bool add_file(const std::string& file_path);
+
+    // Número de filas acumuladas.
+    std::size_t num_rows() const;
+
+    // Coeficientes (beta_0, beta_1, ...) con todas las filas añadidas hasta ahora.
+    std::vector<double> coefficients(bool column_pivoting = false) const;
+
+    // Norma del residuo ||X beta - y||.
+    double residual_norm() const;
+
+    void show() const;
+};
+
 // --- Implementaciones de los métodos de la clase linear_regression ---
 
 linear_regression::linear_regression() {} // Constructor por defecto vacío
@@ -52,8 +104,9 @@ linear_regression::linear_regression() {} // Constructor por defecto vacío
 linear_regression::~linear_regression() {} // Destructor vacío
 
 // Nuevo constructor principal
-linear_regression::linear_regression(const std::string& file_path, const std::string& regression_type)
-    : m_regression_type(regression_type) // Inicializa el tipo de regresión
+linear_regression::linear_regression(const std::string& file_path, const std::string& regression_type,
+                                     const std::string& solver)
+    : m_regression_type(regression_type), m_solver(solver) // Inicializa el tipo de regresión y el método
 {
     // Carga los datos desde el archivo. Si falla, el dataset estará vacío.
     if (!load_data_from_file(file_path)) {
@@ -63,7 +116,7 @@ linear_regression::linear_regression(const std::string& file_path, const std::st
     }
 
     // Si los datos se cargaron correctamente, realiza el cálculo de la regresión.
-    if (!v_dataset.empty()) {
+    if (m_data.rows() > 0) {
         perform_regression_calculation();
     } else {
         std::cerr << "Advertencia: Dataset vacío, no se realizará la regresión." << std::endl;
@@ -72,79 +125,70 @@ linear_regression::linear_regression(const std::string& file_path, const std::st
 
 // Método privado para cargar datos desde un archivo
 bool linear_regression::load_data_from_file(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        // std::cerr ya se maneja en el constructor que llama a esta función.
-        return false; // Fallo al abrir el archivo
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        std::vector<double> row;
-        std::stringstream ss(line);
-        std::string cell;
-        while (std::getline(ss, cell, ' ')) { // Asumiendo espacio como delimitador
-            try {
-                row.push_back(std::stod(cell)); // Convierte string a double
-            } catch (const std::invalid_argument& e) {
-                std::cerr << "Error al parsear el número: " << e.what() << " en línea: " << line << std::endl;
-                v_dataset.clear(); // Limpia el dataset para indicar error
-                return false;
-            } catch (const std::out_of_range& e) {
-                std::cerr << "Número fuera de rango: " << e.what() << " en línea: " << line << std::endl;
-                v_dataset.clear();
-                return false;
-            }
-        }
-        if (!row.empty()) {
-            v_dataset.push_back(row);
-        }
+    try {
+        m_data = load_data_columns(file_path);
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        m_data = DataColumns(); // Limpia el dataset para indicar error
+        return false;
+    }
+    if (m_data.cols() < 2) {
+        std::cerr << "Error: El archivo debe tener al menos un predictor y la variable dependiente." << std::endl;
+        m_data = DataColumns();
+        return false;
     }
-    file.close();
-    return !v_dataset.empty(); // Retorna true si el dataset no está vacío después de la carga
+    return m_data.rows() > 0; // Retorna true si el dataset no está vacío después de la carga
 }
 
 
-// Método privado que contiene la lógica de regresión lineal
+// Método privado que contiene la lógica de regresión lineal.
+// Con "qr" (por defecto) se resuelve min ||X beta - y|| directamente sobre X con QR de
+// Householder, procesando X por bloques de filas: no se forma XᵀX, cuyo número de
+// condición es el cuadrado del de X. Con "cholesky" se resuelven las ecuaciones normales
+// (XᵀX) beta = Xᵀy: XᵀX es simétrica definida positiva, así que se factoriza con Cholesky
+// y, si falla por predictores casi colineales, con LDLᵀ.
 std::vector<double> linear_regression::calculate_linear_regression_coefficients()
 {
-    Matrix<double> m_dataset(v_dataset);
-    int num_predictores = m_dataset.ncol() - 1;
+    const std::size_t num_filas = m_data.rows();
+    const std::size_t num_predictores = m_data.cols() - 1;
 
-    Matrix<double> X(m_dataset.nrow(), num_predictores + 1);
-    for (std::size_t i = 0; i < m_dataset.nrow(); ++i)
+    Matrix<double> X(num_filas, num_predictores + 1);
+    for (std::size_t i = 0; i < num_filas; ++i)
     {
         X(i, 0) = 1.0; // Intercepto
-        for (int j = 0; j < num_predictores; ++j)
+    }
+    for (std::size_t j = 0; j < num_predictores; ++j)
+    {
+        const std::vector<double>& columna = m_data.columns[j];
+        for (std::size_t i = 0; i < num_filas; ++i)
         {
-            X(i, j + 1) = m_dataset(i, j); // Variables predictoras
+            X(i, j + 1) = columna[i]; // Variables predictoras
         }
     }
+    const std::vector<double>& y = m_data.columns[num_predictores]; // Variable dependiente (Y)
 
-    Matrix<double> y(m_dataset.nrow(), 1);
-    for (std::size_t i = 0; i < m_dataset.nrow(); ++i)
-    {
-        y(i, 0) = m_dataset(i, num_predictores); // Variable dependiente (Y)
+    if (m_solver == "qr" || m_solver == "qr_pivoting") {
+        return least_squares_qr(X, y, m_solver == "qr_pivoting");
+    }
+    if (m_solver != "cholesky") {
+        std::cerr << "Error: Método de mínimos cuadrados '" << m_solver << "' no soportado." << std::endl;
+        return std::vector<double>();
     }
 
-    Matrix<double> Xt = transpuesta(X);
-    Matrix<double> XtX = Xt * X;
-    Matrix<double> XtX_inv = inversa(XtX);
-    
-    if (XtX_inv.nrow() == 0 && XtX_inv.ncol() == 0) {
-        std::cerr << "Error en linear_regression::calculate_linear_regression_coefficients(): La matriz (X^T * X) es singular, no se puede calcular la inversa." << std::endl;
-        return std::vector<double>(); // Retorna vector vacío si hay error
+    Matrix<double> XtX = gram_matrix(X);
+    std::vector<double> Xty = transpose_times(X, y);
+
+    Cholesky<double> cholesky(XtX);
+    if (cholesky.is_positive_definite()) {
+        return cholesky.solve(Xty);
     }
 
-    Matrix<double> coeficientes_matriz = (XtX_inv * Xt) * y;
-    
-    std::vector<double> coeficientes;
-    for (std::size_t i = 0; i < coeficientes_matriz.nrow(); ++i)
-    {
-        coeficientes.push_back(coeficientes_matriz(i, 0));
+    LDLT<double> ldlt(XtX);
+    if (ldlt.is_singular()) {
+        std::cerr << "Error en linear_regression::calculate_linear_regression_coefficients(): La matriz (X^T * X) es singular, no se pueden calcular los coeficientes." << std::endl;
+        return std::vector<double>(); // Retorna vector vacío si hay error
     }
-    
-    return coeficientes;
+    return ldlt.solve(Xty);
 }
 
 // Método privado para orquestar el cálculo (permite añadir otros tipos de regresión en el futuro)
@@ -165,25 +209,112 @@ void linear_regression::perform_regression_calculation() {
 // Método público para mostrar los resultados
 void linear_regression::show() const
 {
-    if (m_coefficients.empty()) {
+    print_regression_coefficients(m_coefficients, m_regression_type);
+}
+
+// --- Funciones auxiliares ---
+
+void print_regression_coefficients(const std::vector<double>& coefficients, const std::string& regression_type)
+{
+    if (coefficients.empty()) {
         std::cout << "No hay coeficientes para mostrar. La regresión no se pudo calcular o el dataset está vacío." << std::endl;
         return;
     }
 
-    std::cout << "\n--- Resultados de la Regresión (" << m_regression_type << ") ---" << std::endl;
+    std::cout << "\n--- Resultados de la Regresión (" << regression_type << ") ---" << std::endl;
     std::cout << "Coeficientes calculados:" << std::endl;
-    std::cout << "  Intercepto (beta_0): " << m_coefficients[0] << std::endl;
+    std::cout << "  Intercepto (beta_0): " << coefficients[0] << std::endl;
 
-    for (std::size_t i = 1; i < m_coefficients.size(); ++i) {
-        std::cout << "  Coeficiente de X" << i << " (beta_" << i << "): " << m_coefficients[i] << std::endl;
+    for (std::size_t i = 1; i < coefficients.size(); ++i) {
+        std::cout << "  Coeficiente de X" << i << " (beta_" << i << "): " << coefficients[i] << std::endl;
     }
 
     // Si es una regresión lineal simple (un solo predictor), podemos mostrar la ecuación de la recta.
-    if (m_coefficients.size() == 2 && m_regression_type == "linear") {
+    if (coefficients.size() == 2 && regression_type == "linear") {
         std::cout << "\nEcuación del modelo: Y = " 
-                  << m_coefficients[1] << "X + " << m_coefficients[0] << std::endl;
+                  << coefficients[1] << "X + " << coefficients[0] << std::endl;
     }
     std::cout << "------------------------------------------\n" << std::endl;
 }
 
+// --- Implementaciones de los métodos de la clase streaming_linear_regression ---
+
+streaming_linear_regression::streaming_linear_regression() {}
+
+streaming_linear_regression::~streaming_linear_regression() {}
+
+streaming_linear_regression::streaming_linear_regression(const std::string& file_path)
+{
+    if (!add_file(file_path)) {
+        std::cerr << "Error: No se pudo cargar el archivo de datos '" << file_path << "'." << std::endl;
+    }
+}
+
+bool streaming_linear_regression::add_row(const std::vector<double>& row)
+{
+    if (row.empty()) return true; // Líneas vacías
+    if (!m_initialized) {
+        if (row.size() < 2) {
+            std::cerr << "Error: Cada fila debe tener al menos un predictor y la variable dependiente." << std::endl;
+            return false;
+        }
+        m_num_predictores = row.size() - 1;
+        m_accumulator = QRAccumulator<double>(m_num_predictores + 1);
+        m_row.assign(m_num_predictores + 1, 1.0);
+        m_initialized = true;
+    }
+    if (row.size() != m_num_predictores + 1) {
+        std::cerr << "Error: La fila tiene " << row.size() << " columnas, se esperaban " << m_num_predictores + 1 << "." << std::endl;
+        return false;
+    }
+    for (std::size_t j = 0; j < m_num_predictores; ++j) {
+        m_row[j + 1] = row[j]; // m_row[0] = 1 (intercepto)
+    }
+    m_accumulator.add_row(m_row.data(), row[m_num_predictores]);
+    return true;
+}
+
+bool streaming_linear_regression::add_batch(const std::vector<std::vector<double>>& batch)
+{
+    for (const std::vector<double>& row : batch) {
+        if (!add_row(row)) return false;
+    }
+    return true;
+}
+
+bool streaming_linear_regression::add_file(const std::string& file_path)
+{
+    try {
+        // Las filas anteriores a una línea con error quedan en el ajuste.
+        return for_each_data_row(file_path, [this](const std::vector<double>& row) { return add_row(row); });
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+}
+
+std::size_t streaming_linear_regression::num_rows() const
+{
+    return m_accumulator.count();
+}
+
+std::vector<double> streaming_linear_regression::coefficients(bool column_pivoting) const
+{
+    if (!m_initialized || m_accumulator.count() == 0) {
+        return std::vector<double>();
+    }
+    return m_accumulator.solve(column_pivoting);
+}
+
+double streaming_linear_regression::residual_norm() const
+{
+    return m_initialized ? m_accumulator.residual_norm() : 0.0;
+}
+
+void streaming_linear_regression::show() const
+{
+    print_regression_coefficients(coefficients(), "linear");
+    std::cout << "Filas procesadas: " << num_rows() << ", norma del residuo: " << residual_norm() << std::endl;
+}
+
 #endif
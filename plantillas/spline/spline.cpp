@@ -1,37 +1,32 @@
 #include <cmath>
 #include <fstream>
 #include <stdexcept>
+#include <vector>
 #include "spline.h"
+#include "data_loader.h"
 
 // constructor que carga los datos desde un archivo y construye el spline
 Spline::Spline(const std::string& archivo, Tipo tipo)
 {
     
-    std::ifstream data(archivo);
-    VecD nuevos_x, nuevos_y;
-    double xval, yval;
-    // lee pares (x, y) del archivo
-    while (data >> xval >> yval)
-    {
-        nuevos_x.push_back(xval);
-        nuevos_y.push_back(yval);
-    }
-    data.close();
+    // lee las columnas (x, y) del archivo (mapeado en memoria y convertido en paralelo)
+    DataColumns datos = load_data_columns(archivo);
 
     // verifica que se hayan leído datos válidos
-    if (nuevos_x.empty() || nuevos_y.empty()) {
+    if (datos.cols() < 2 || datos.rows() == 0) {
         throw std::runtime_error("El archivo está vacío o no contiene datos válidos.");
     }
 
     // inicializa los vectores y parámetros
-    x = nuevos_x;
-    y = nuevos_y;
+    x = std::move(datos.columns[0]);
+    y = std::move(datos.columns[1]);
     n = static_cast<int>(x.size()) - 1;
     tipoSpline = tipo;
     a = VecD(n);
     b = VecD(n);
     c = VecD(n+1);
     d = VecD(n);
+    detectarUniformes();
 
     // construye el spline según el tipo
     if (tipoSpline == Natural)
@@ -52,6 +47,7 @@ Spline::Spline(const VecD& puntosX, const VecD& puntosY, Tipo tipo)
     b = VecD(n);
     c = VecD(n+1);
     d = VecD(n);
+    detectarUniformes();
     // construye el spline según el tipo
     if (tipoSpline == Natural)
         construirNatural();
@@ -137,18 +133,53 @@ void Spline::construirPeriodico()
     }
 }
 
+// decide si los nodos son equiespaciados (hasta el redondeo): en ese caso el tramo de
+// x_eval es floor((x_eval - x[0]) / h) y no hace falta buscar
+void Spline::detectarUniformes()
+{
+    
+    nodosUniformes = false;
+    invPaso = 0.0;
+    if (n < 1) return;
+    double paso = (x[n] - x[0]) / n;
+    double tolerancia = 1e-12 * std::fabs(x[n] - x[0]);
+    for (int i = 1; i < n; ++i)
+    {
+        if (std::fabs(x[i] - (x[0] + i*paso)) > tolerancia) return;
+    }
+    nodosUniformes = true;
+    invPaso = 1.0 / paso;
+}
+
 // busca el tramo del spline donde se encuentra el valor x_eval
 int Spline::buscarTramo(double x_eval) const
 {
     
     if (x_eval <= x[0]) return 0;
-    if (x_eval >= x[n]) return n-1;
-    for (int i = 0; i < n; ++i)
+    if (!(x_eval < x[n])) return n-1; // también NaN
+    if (nodosUniformes)
+    {
+        // estimación directa; el redondeo puede dejarla a un tramo de distancia
+        int i = std::min(static_cast<int>((x_eval - x[0])*invPaso), n-1);
+        while (x_eval < x[i]) --i;
+        while (i < n-1 && x_eval >= x[i+1]) ++i;
+        return i;
+    }
+    // búsqueda binaria: el primer nodo mayor que x_eval cierra el tramo
+    return static_cast<int>(std::upper_bound(x.begin(), x.end(), x_eval) - x.begin()) - 1;
+}
+
+// igual que buscarTramo(x_eval), pero mira primero el tramo 'pista' y el siguiente: con
+// consultas ordenadas casi siempre acierta sin buscar
+int Spline::buscarTramo(double x_eval, int pista) const
+{
+    
+    if (pista >= 0 && pista < n && x_eval >= x[pista])
     {
-        if (x_eval >= x[i] && x_eval < x[i+1])
-            return i;
+        if (pista == n-1 || x_eval < x[pista+1]) return pista;
+        if (pista+1 == n-1 || x_eval < x[pista+2]) return pista+1;
     }
-    return n-1;
+    return buscarTramo(x_eval);
 }
 
 // evalúa el spline en el punto x_eval
@@ -157,7 +188,54 @@ double Spline::evaluar(double x_eval) const
     
     int i = buscarTramo(x_eval);
     double dx = x_eval - x[i];
-    return a[i] + b[i]*dx + c[i]*dx*dx + d[i]*dx*dx*dx;
+    return a[i] + dx*(b[i] + dx*(c[i] + dx*d[i]));
+}
+
+// evalúa el spline en x_eval usando y actualizando el cursor 'pista' (empezar con 0)
+double Spline::evaluar(double x_eval, int& pista) const
+{
+    
+    pista = buscarTramo(x_eval, pista);
+    double dx = x_eval - x[pista];
+    return a[pista] + dx*(b[pista] + dx*(c[pista] + dx*d[pista]));
+}
+
+// ye[k] = a[i] + dx (b[i] + dx (c[i] + dx d[i])) con i = tramo[k], dx = xe[k] - x[i]; con
+// __restrict en los parámetros el compilador sabe que ye no pisa los coeficientes y
+// vectoriza el ciclo (las lecturas de a, b, c, d son gathers)
+static void evaluarCubicas(const int* __restrict tramo, const double* __restrict xe, double* __restrict ye,
+                           std::size_t m, const double* __restrict xx, const double* __restrict aa,
+                           const double* __restrict bb, const double* __restrict cc, const double* __restrict dd)
+{
+    
+    for (std::size_t k = 0; k < m; ++k)
+    {
+        int i = tramo[k];
+        double dx = xe[k] - xx[i];
+        ye[k] = aa[i] + dx*(bb[i] + dx*(cc[i] + dx*dd[i]));
+    }
+}
+
+// evalúa el spline en m puntos: out[k] = S(xs[k]). Por bloques, primero se buscan todos
+// los tramos (con el tramo anterior como pista, así que xs ordenados salen casi gratis) y
+// después se evalúan los polinomios en un ciclo sin saltos
+void Spline::evaluar(const double* xs, double* out, std::size_t m) const
+{
+    
+    const std::size_t bloque = 256;
+    int tramo[bloque];
+    int pista = 0;
+    for (std::size_t inicio = 0; inicio < m; inicio += bloque)
+    {
+        std::size_t cuantos = std::min(bloque, m - inicio);
+        for (std::size_t k = 0; k < cuantos; ++k)
+        {
+            pista = buscarTramo(xs[inicio + k], pista);
+            tramo[k] = pista;
+        }
+        evaluarCubicas(tramo, xs + inicio, out + inicio, cuantos,
+                       x.data(), a.data(), b.data(), c.data(), d.data());
+    }
 }
 
 // exporta los valores del spline a un archivo, generando cantidadPuntos puntos
@@ -168,10 +246,15 @@ void Spline::exportar(const std::string& archivo, int cantidadPuntos) const
     double xmin = x[0];
     double xmax = x[n];
     double paso = (xmax - xmin) / (cantidadPuntos-1);
-    for (int i = 0; i < cantidadPuntos; ++i)
+    // los puntos se evalúan por bloques con evaluar(xs, out, m)
+    const int bloque = 4096;
+    std::vector<double> xs(bloque), ys(bloque);
+    for (int inicio = 0; inicio < cantidadPuntos; inicio += bloque)
     {
-        double xval = xmin + i*paso;
-        out << xval << " " << evaluar(xval) << std::endl;
+        int cuantos = std::min(bloque, cantidadPuntos - inicio);
+        for (int k = 0; k < cuantos; ++k) xs[k] = xmin + (inicio + k)*paso;
+        evaluar(xs.data(), ys.data(), cuantos);
+        for (int k = 0; k < cuantos; ++k) out << xs[k] << " " << ys[k] << '\n';
     }
     out.close();
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <stdexcept>
 #include <algorithm>
+#include <cstddef>
 
 
 using VecD = std::vector<double>;
@@ -21,6 +22,8 @@ public:
 
 
     double evaluar(double x_eval) const; // evalúa spline
+    double evaluar(double x_eval, int& pista) const; // con cursor: pista es el último tramo usado
+    void evaluar(const double* xs, double* out, std::size_t m) const; // out[k] = S(xs[k]), por lotes
     void exportar(const std::string& archivo, int cantidadPuntos) const; // exporta a archivo
 
 
@@ -28,11 +31,15 @@ private:
     VecD x, y, a, b, c, d; // datos y coeficientes
     int n; // cantidad de tramos
     Tipo tipoSpline; // tipo actual
+    bool nodosUniformes; // x[i] = x[0] + i h: el tramo se calcula en O(1)
+    double invPaso; // 1 / h si los nodos son uniformes
 
 
     void construirNatural(); // spline natural
     void construirPeriodico(); // spline periódico
+    void detectarUniformes(); // decide si los nodos son equiespaciados
     int buscarTramo(double x_eval) const; // busca tramo
+    int buscarTramo(double x_eval, int pista) const; // busca tramo empezando por la pista
 
 };
 
@@ -36,36 +36,56 @@ Ajuste<T>::Ajuste(vector<vector<double>> v_dataset)
 }
 
 // Ajuste lineal multivariable
+// Se resuelven las ecuaciones normales (X^T*X)*c = X^T*y sin calcular la
+// inversa: X^T*X es simetrica, asi que solo se acumula su triangulo inferior
+// (fila por fila de los datos) y se resuelve con Cholesky, o con LDL^T si
+// Cholesky falla por predictores casi colineales.
 template <class T>
 vector<double> Ajuste<T>::lineal()
 {
-    Matriz<double> m_dataset(v_dataset);
-    int orden = m_dataset.ncol()-1;
+    int n = v_dataset.size();
+    int orden = v_dataset[0].size()-1;
 
-    Matriz<double> X(m_dataset.nrow(), orden+1);
-    
-    for (int i = 0; i < m_dataset.nrow(); i+=1)
+    Matriz<double> XtX(orden+1, orden+1);
+    vector<double> Xty(orden+1, 0.0);
+    vector<double> x(orden+1);
+
+    for (int i = 0; i < n; i+=1)
     {
-        X(i,0) = 1;
+        x[0] = 1;
         for (int j = 1; j < orden+1; j+=1)
         {
-            X(i,j) = m_dataset(i, j-1);
+            x[j] = v_dataset[i][j-1];
+        }
+        double y = v_dataset[i][orden];
+
+        for (int j = 0; j < orden+1; j+=1)
+        {
+            for (int k = 0; k <= j; k+=1)
+            {
+                XtX(j,k) = XtX(j,k) + x[j]*x[k];
+            }
+            Xty[j] = Xty[j] + x[j]*y;
         }
     }
 
-    Matriz<double> y(m_dataset.nrow(), 1);
-    
-    for (int i = 0; i < m_dataset.nrow(); i+=1)
+    // Triangulo superior por simetria
+    for (int j = 0; j < orden+1; j+=1)
     {
-        y(i,0) = m_dataset(i, orden);
+        for (int k = j+1; k < orden+1; k+=1)
+        {
+            XtX(j,k) = XtX(k,j);
+        }
     }
 
-    Matriz<double> constantes_matriz = (inversa(transpuesta(X)*X)*transpuesta(X))*y;
-    vector<double> constantes;
-    
-    for (int i = 0; i < orden+1; i+=1)
+    vector<double> constantes = cholesky(XtX, Xty);
+    if (constantes.empty())
+    {
+        constantes = ldlt(XtX, Xty);
+    }
+    if (constantes.empty())
     {
-        constantes.push_back(constantes_matriz.get()[i][0]);
+        cerr << "Error: la matriz X^T*X es singular, no se puede realizar el ajuste." << endl;
     }
     return constantes;
 }
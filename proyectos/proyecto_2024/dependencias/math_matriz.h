@@ -45,6 +45,12 @@ T determinante(const Matriz<T> &); // determinante
 template <class T>
 Matriz<T> inversa(const Matriz<T> &); // matriz inversa
 
+template <class T>
+vector<T> cholesky(const Matriz<T> &, const vector<T> &); // resuelve Ax = b con A simetrica definida positiva
+
+template <class T>
+vector<T> ldlt(const Matriz<T> &, const vector<T> &); // resuelve Ax = b con A simetrica (sin raices)
+
 
 /*Implementacion de la clase*/
 
@@ -473,6 +479,122 @@ Matriz<T> inversa(const Matriz<T> & x)
     return m_inversa;
 }
 
+///////////// Cholesky /////////////
+// A = L*L^T. Solo se lee el triangulo inferior de A y L se guarda en una
+// matriz triangular (fila i de largo i+1). Si A no es definida positiva
+// retorna un vector vacio.
+template <class T>
+vector<T> cholesky(const Matriz<T> & A, const vector<T> & b)
+{
+    int n = A.nrow();
+    vector<vector<T>> L(n);
+
+    for (int i = 0; i < n; i+=1)
+    {
+        L[i].resize(i+1);
+        for (int j = 0; j <= i; j+=1)
+        {
+            T suma = A(i, j);
+            for (int k = 0; k < j; k+=1)
+            {
+                suma = suma - L[i][k]*L[j][k];
+            }
+            if (i == j)
+            {
+                if (!(suma > 0))
+                {
+                    return vector<T>();
+                }
+                L[i][i] = sqrt(suma);
+            }
+            else
+            {
+                L[i][j] = suma/L[j][j];
+            }
+        }
+    }
+
+    // Sustitucion hacia adelante: L*z = b
+    vector<T> x = b;
+    for (int i = 0; i < n; i+=1)
+    {
+        for (int k = 0; k < i; k+=1)
+        {
+            x[i] = x[i] - L[i][k]*x[k];
+        }
+        x[i] = x[i]/L[i][i];
+    }
+
+    // Sustitucion hacia atras: L^T*x = z
+    for (int i = n-1; i >= 0; i-=1)
+    {
+        x[i] = x[i]/L[i][i];
+        for (int k = 0; k < i; k+=1)
+        {
+            x[k] = x[k] - L[i][k]*x[i];
+        }
+    }
+    return x;
+}
+
+///////////// LDL^T /////////////
+// A = L*D*L^T con L de diagonal unitaria (D se guarda en la diagonal de L).
+// Sirve cuando A es simetrica pero no definida positiva. Si algun elemento
+// de D es (casi) cero retorna un vector vacio.
+template <class T>
+vector<T> ldlt(const Matriz<T> & A, const vector<T> & b)
+{
+    int n = A.nrow();
+    vector<vector<T>> L(n);
+    vector<T> w(n); // w[k] = L(i,k)*D(k)
+
+    for (int i = 0; i < n; i+=1)
+    {
+        L[i].resize(i+1);
+        for (int j = 0; j < i; j+=1)
+        {
+            T suma = A(i, j);
+            for (int k = 0; k < j; k+=1)
+            {
+                suma = suma - w[k]*L[j][k];
+            }
+            w[j] = suma;
+            L[i][j] = suma/L[j][j];
+        }
+        T d = A(i, i);
+        for (int k = 0; k < i; k+=1)
+        {
+            d = d - w[k]*L[i][k];
+        }
+        if (abs(d) < 1e-12)
+        {
+            return vector<T>();
+        }
+        L[i][i] = d;
+    }
+
+    vector<T> x = b;
+    for (int i = 0; i < n; i+=1)
+    {
+        for (int k = 0; k < i; k+=1)
+        {
+            x[i] = x[i] - L[i][k]*x[k];
+        }
+    }
+    for (int i = 0; i < n; i+=1)
+    {
+        x[i] = x[i]/L[i][i];
+    }
+    for (int i = n-1; i >= 0; i-=1)
+    {
+        for (int k = 0; k < i; k+=1)
+        {
+            x[k] = x[k] - L[i][k]*x[i];
+        }
+    }
+    return x;
+}
+
 template <class T>
 void Matriz<T>::save(string path)
 {
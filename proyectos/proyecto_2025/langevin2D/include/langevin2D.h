@@ -2,27 +2,70 @@
 #define LANGEVIN_SYSTEM_2D_H
 
 #include <vector>
+#include <array>
 #include <random>
+#include <cmath>
+#include <cstdint>
+#include "philox.h"
 
 class LangevinSystem2D
 {
 public:
     enum NoiseType { UNIFORM, GAUSSIAN };
+    using State = std::array<double, 4>; // estado de tamaño fijo para rk4_array
+
+    // parametros del ruido: uniforme en [-a, a] o gaussiano de media 0 y desviacion sigma
+    static constexpr double uniform_amplitude = 0.1;
+    static constexpr double gaussian_sigma = 0.05;
 
 private:
     NoiseType noise_type_;
-    std::mt19937 gen_; // cada sistema tiene su propio generador de numeros aleatorios
-    std::uniform_real_distribution<> uniform_dist_;
-    std::normal_distribution<> gaussian_dist_;
     double gamma_; // coeficiente de friccion
+    PhiloxStream gen_; // cada sistema tiene su propio generador de numeros aleatorios
+    // el ruido se genera por lotes (ver philox.h) y noise() los entrega de a uno
+    static constexpr std::size_t noise_batch = 64;
+    double noise_buffer_[noise_batch];
+    std::size_t noise_next_ = noise_batch;
+
+    void refillNoise();
+    // un valor del ruido eta segun el tipo elegido
+    double noise()
+    {
+        if (noise_next_ == noise_batch) refillNoise();
+        return noise_buffer_[noise_next_++];
+    }
 
 public:
     // constructor que inicializa el tipo de ruido y los generadores
     LangevinSystem2D(NoiseType type, double gamma = 0.5);
+    // con semilla fija la secuencia de ruido es reproducible
+    LangevinSystem2D(NoiseType type, double gamma, std::uint64_t seed);
     
     // operator() permite que los objetos de esta clase sean llamados como si fueran funciones
     std::vector<double> operator()(double t, const std::vector<double>& y);
+    // misma ecuacion con estado de tamaño fijo; se define aqui para que el compilador
+    // la pueda expandir dentro del paso de RK4
+    State operator()(double t, const State& y)
+    {
+        const double eta_x = noise();
+        const double eta_y = noise();
+        return {y[1], -gamma_ * y[1] + eta_x, y[3], -gamma_ * y[3] + eta_y};
+    }
     
+    // forma de ecuacion estocastica para sde_array (ver sde_array.h):
+    // dx = v dt, dv = -gamma v dt + b dW, con b la desviacion estandar de eta
+    State deriva(double t, const State& y) const { return {y[1], -gamma_ * y[1], y[3], -gamma_ * y[3]}; }
+    State fuerza(double t, const State& y) const { return {}; } // particula libre
+    State difusion(double t, const State& y) const { return {0.0, noiseStd(), 0.0, noiseStd()}; }
+    // eta / b: media 0 y varianza 1, con la forma del ruido elegido
+    State ruido()
+    {
+        const double inv_b = 1.0 / noiseStd();
+        return {0.0, noise() * inv_b, 0.0, noise() * inv_b};
+    }
+    static double noiseStd(NoiseType type) { return type == UNIFORM ? uniform_amplitude / std::sqrt(3.0) : gaussian_sigma; }
+    double noiseStd() const { return noiseStd(noise_type_); }
+
     // metodos para acceder/modificar parametros
     void setGamma(double gamma) { gamma_ = gamma; }
     double getGamma() const { return gamma_; }
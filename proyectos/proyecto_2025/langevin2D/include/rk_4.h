@@ -5,6 +5,7 @@
 #include <string>
 #include <functional>
 #include <vector>
+#include "trajectory_sink.h"
 
 class rk4
 {
@@ -20,6 +21,11 @@ public:
     void integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, const std::string& archivo_salida);
     void integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, const std::string& archivo_salida);
 
+    // Igual que las anteriores, pero escriben los estados en un destino cualquiera
+    // (por ejemplo BinaryTrajectorySink). Las versiones con nombre de archivo usan texto.
+    void integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, TrajectorySink& salida);
+    void integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, TrajectorySink& salida);
+
 };
 
 #endif
\ No newline at end of file
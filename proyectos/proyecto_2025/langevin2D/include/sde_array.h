@@ -0,0 +1,146 @@
+#ifndef SDE_ARRAY_H
+#define SDE_ARRAY_H
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include "trajectory_sink.h"
+
+// Integradores de paso fijo para ecuaciones diferenciales estocásticas con ruido aditivo
+// (diagonal) de dimensión fija:
+//     dy_i = a_i(t, y) dt + b_i(t) dW_i
+// donde W_i son procesos de Wiener independientes. A diferencia de meter el ruido en el
+// lado derecho de rk4 (que sortea un ruido distinto en cada etapa y no lo escala con el
+// paso), aquí se sortea un incremento dW = sqrt(h) xi por paso, con xi de media 0 y
+// varianza 1, así que el resultado converge al mismo proceso cuando h -> 0 y se pueden
+// usar pasos mucho más grandes.
+//
+// El sistema S debe tener (State = std::array<double, N>):
+//     State deriva(double t, const State& y)    a(t, y)
+//     State difusion(double t, const State& y)  b_i (0 en las componentes sin ruido)
+//     State ruido()                             N valores xi independientes (media 0, varianza 1)
+// y para BAOAB, que es solo para Langevin, el estado va por pares y = (x0, v0, x1, v1, ...)
+// con dx = v dt, dv = F(x) dt - gamma v dt + b dW, y además:
+//     State fuerza(double t, const State& y)    F en las componentes de velocidad (sin fricción)
+//     double getGamma() const
+//
+// Esquemas (orden fuerte / orden débil con ruido aditivo):
+// - EULER_MARUYAMA: y + a h + b dW.                                            1 / 1
+// - HEUN: predictor de Euler-Maruyama y corrector trapezoidal con el mismo dW.  1 / 2 (a lineal)
+// - BAOAB (Leimkuhler y Matthews, 2013): medio paso de fuerza (B), medio paso de
+//   posición (A), la fricción y el ruido resueltos de forma exacta en h (O), y de nuevo
+//   A y B. Con fuerza nula las velocidades tienen la distribución exacta para cualquier
+//   h, y en general da el equilibrio con error O(h²) y es estable para gamma h grande.
+enum class EsquemaSDE { EULER_MARUYAMA, HEUN, BAOAB };
+
+template <std::size_t N, class S>
+class sde_array
+{
+public:
+    using State = std::array<double, N>;
+
+private:
+    S s;
+
+    // res[i] = y[i] + h a[i] + sqrt(h) b[i] xi[i]
+    template <std::size_t... I>
+    static State euler(const State& y, double h, const State& a, double sqrt_h, const State& b, const State& xi,
+                       std::index_sequence<I...>) {
+        return State{(y[I] + h * a[I] + sqrt_h * b[I] * xi[I])...};
+    }
+
+    template <std::size_t... I>
+    static State trapecio(const State& y, double h, const State& a1, const State& a2, double sqrt_h,
+                          const State& b1, const State& b2, const State& xi, std::index_sequence<I...>) {
+        return State{(y[I] + 0.5 * h * (a1[I] + a2[I]) + 0.5 * sqrt_h * (b1[I] + b2[I]) * xi[I])...};
+    }
+
+public:
+    explicit sde_array(S s) : s(std::forward<S>(s)) {}
+
+    State paso_euler_maruyama(double t, const State& y, double h) {
+        const State xi = s.ruido();
+        return euler(y, h, s.deriva(t, y), std::sqrt(h), s.difusion(t, y), xi, std::make_index_sequence<N>{});
+    }
+
+    State paso_heun(double t, const State& y, double h) {
+        constexpr auto idx = std::make_index_sequence<N>{};
+        const double sqrt_h = std::sqrt(h);
+        const State xi = s.ruido();
+        const State a1 = s.deriva(t, y);
+        const State b1 = s.difusion(t, y);
+        const State y_pred = euler(y, h, a1, sqrt_h, b1, xi, idx);
+        return trapecio(y, h, a1, s.deriva(t + h, y_pred), sqrt_h, b1, s.difusion(t + h, y_pred), xi, idx);
+    }
+
+    State paso_baoab(double t, const State& y, double h) {
+        static_assert(N % 2 == 0, "BAOAB necesita el estado por pares (x, v)");
+        const double gamma = s.getGamma();
+        const double c1 = std::exp(-gamma * h);
+        // varianza exacta del proceso de Ornstein-Uhlenbeck en h: b² (1 - c1²) / (2 gamma),
+        // que tiende a b² h cuando gamma -> 0
+        const double c2 = (gamma > 0.0) ? std::sqrt(-std::expm1(-2.0 * gamma * h) / (2.0 * gamma)) : std::sqrt(h);
+        const State xi = s.ruido();
+        const State b = s.difusion(t, y);
+
+        State z = y;
+        State F = s.fuerza(t, z);
+        for (std::size_t i = 1; i < N; i += 2) z[i] += 0.5 * h * F[i];      // B
+        for (std::size_t i = 0; i < N; i += 2) z[i] += 0.5 * h * z[i + 1];  // A
+        for (std::size_t i = 1; i < N; i += 2) z[i] = c1 * z[i] + c2 * b[i] * xi[i];  // O
+        for (std::size_t i = 0; i < N; i += 2) z[i] += 0.5 * h * z[i + 1];  // A
+        F = s.fuerza(t + h, z);
+        for (std::size_t i = 1; i < N; i += 2) z[i] += 0.5 * h * F[i];      // B
+        return z;
+    }
+
+    State paso(EsquemaSDE esquema, double t, const State& y, double h) {
+        switch (esquema) {
+            case EsquemaSDE::EULER_MARUYAMA: return paso_euler_maruyama(t, y, h);
+            case EsquemaSDE::HEUN: return paso_heun(t, y, h);
+            case EsquemaSDE::BAOAB: return paso_baoab(t, y, h);
+        }
+        return y;
+    }
+
+    void integrar_paso_fijo(EsquemaSDE esquema, const State& y0, double t0, double tf, double h, const std::string& archivo_salida) {
+        TextTrajectorySink data(archivo_salida);
+        integrar_paso_fijo(esquema, y0, t0, tf, h, data);
+    }
+
+    // Escribe y(t0 + k h) para k = 0..n con n = round((tf - t0) / h); el tiempo se calcula
+    // como t0 + k h para no acumular el error de redondeo de t += h.
+    void integrar_paso_fijo(EsquemaSDE esquema, const State& y0, double t0, double tf, double h, TrajectorySink& data) {
+        // el esquema se elige una vez, fuera del ciclo
+        switch (esquema) {
+            case EsquemaSDE::EULER_MARUYAMA: integrar<EsquemaSDE::EULER_MARUYAMA>(y0, t0, tf, h, data); break;
+            case EsquemaSDE::HEUN: integrar<EsquemaSDE::HEUN>(y0, t0, tf, h, data); break;
+            case EsquemaSDE::BAOAB: integrar<EsquemaSDE::BAOAB>(y0, t0, tf, h, data); break;
+        }
+    }
+
+private:
+    template <EsquemaSDE E>
+    void integrar(const State& y0, double t0, double tf, double h, TrajectorySink& data) {
+        const long long n = std::llround((tf - t0) / h);
+        data.begin(N);
+
+        State y = y0;
+        data.write(t0, y.data());
+        for (long long k = 0; k < n; ++k) {
+            y = paso(E, t0 + double(k) * h, y, h);
+            data.write(t0 + double(k + 1) * h, y.data());
+        }
+        data.finish();
+    }
+};
+
+// Como make_rk4_array: con un objeto con nombre guarda una referencia (y usa su generador).
+template <std::size_t N, class S>
+sde_array<N, S> make_sde_array(S&& s) {
+    return sde_array<N, S>(std::forward<S>(s));
+}
+
+#endif
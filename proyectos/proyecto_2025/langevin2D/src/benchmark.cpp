@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "rk_4.h"
+#include "rk_4_array.h"
+#include "langevin2D.h"
+
+using namespace std;
+
+// compara rk4 (std::vector + std::function) con rk4_array (std::array<double, 4> y el
+// sistema expandido en linea) integrando el mismo problema que main.cpp
+
+const double T0 = 0.0;
+const double TF = 500.0;
+const double H = 0.01;
+const double GAMMA = 0.5;
+const int REPETICIONES = 20;
+
+// destino que no escribe nada: solo cuenta los estados y guarda el ultimo
+class UltimoEstado : public TrajectorySink
+{
+public:
+    vector<double> y;
+    size_t filas = 0;
+
+    void begin(size_t dimension) override { y.assign(dimension, 0.0); filas = 0; }
+    void write(double t, const double* estado) override { copy(estado, estado + y.size(), y.begin()); ++filas; }
+    void finish() override {}
+};
+
+// tiempo por paso (en nanosegundos) de integrar REPETICIONES veces
+template <class Integrar>
+double medir(Integrar&& integrar, UltimoEstado& salida)
+{
+    auto inicio = chrono::steady_clock::now();
+    for (int r = 0; r < REPETICIONES; ++r) integrar(salida);
+    auto fin = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(fin - inicio).count() / (REPETICIONES * double(salida.filas));
+}
+
+void comparar(const string& name, LangevinSystem2D::NoiseType tipo)
+{
+    const LangevinSystem2D::State y0 = {0.5, 0.0, 0.5, 0.1};
+    const vector<double> y0_vector(y0.begin(), y0.end());
+
+    // dos copias del mismo sistema: ambos integradores ven la misma secuencia de ruido
+    LangevinSystem2D sistema(tipo, GAMMA);
+    LangevinSystem2D copia = sistema;
+
+    UltimoEstado salida_vector, salida_array;
+    rk4 solver_vector(sistema);
+    double ns_vector = medir([&](UltimoEstado& s) { solver_vector.integrar_paso_fijo(y0_vector, T0, TF, H, s); }, salida_vector);
+    auto solver_array = make_rk4_array<4>(copia);
+    double ns_array = medir([&](UltimoEstado& s) { solver_array.integrar_paso_fijo(y0, T0, TF, H, s); }, salida_array);
+
+    double diferencia = 0.0;
+    for (size_t i = 0; i < y0.size(); ++i)
+        diferencia = max(diferencia, abs(salida_vector.y[i] - salida_array.y[i]));
+
+    cout << "ruido " << setw(9) << left << name << right << fixed << setprecision(1)
+         << "  rk4: " << setw(6) << ns_vector << " ns/paso"
+         << "  rk4_array: " << setw(6) << ns_array << " ns/paso"
+         << "  (x" << setprecision(2) << ns_vector / ns_array << ")"
+         << "  diferencia final: " << scientific << setprecision(1) << diferencia << defaultfloat << endl;
+}
+
+int main()
+{
+    cout << "Langevin 2D, " << (TF - T0) / H << " pasos x " << REPETICIONES << " repeticiones" << endl;
+    comparar("uniforme", LangevinSystem2D::UNIFORM);
+    comparar("gaussiano", LangevinSystem2D::GAUSSIAN);
+    return 0;
+}
@@ -1,28 +1,39 @@
 #include "langevin2D.h"
 
+namespace
+{
+    std::uint64_t randomSeed()
+    {
+        std::random_device rd;
+        return (std::uint64_t(rd()) << 32) | rd();
+    }
+}
+
 LangevinSystem2D::LangevinSystem2D(NoiseType type, double gamma)
+    : LangevinSystem2D(type, gamma, randomSeed()) // inicializa con una semilla aleatoria
+{
+}
+
+LangevinSystem2D::LangevinSystem2D(NoiseType type, double gamma, std::uint64_t seed)
     : noise_type_(type),
       gamma_(gamma),
-      gen_(std::random_device{}()), // inicializa con una semilla aleatoria
-      uniform_dist_(-0.1, 0.1),
-      gaussian_dist_(0.0, 0.05)
+      gen_(seed)
 {
 }
 
-std::vector<double> LangevinSystem2D::operator()(double t, const std::vector<double>& y)
+void LangevinSystem2D::refillNoise()
 {
-    double eta_x, eta_y;
-
     if (noise_type_ == UNIFORM)
-    {
-        eta_x = uniform_dist_(gen_);
-        eta_y = uniform_dist_(gen_);
-    }
+        gen_.uniformes(noise_buffer_, noise_batch, -uniform_amplitude, uniform_amplitude);
     else
-    {
-        eta_x = gaussian_dist_(gen_);
-        eta_y = gaussian_dist_(gen_);
-    }
+        gen_.normales(noise_buffer_, noise_batch, 0.0, gaussian_sigma);
+    noise_next_ = 0;
+}
+
+std::vector<double> LangevinSystem2D::operator()(double t, const std::vector<double>& y)
+{
+    const double eta_x = noise();
+    const double eta_y = noise();
 
     // y[0]=x, y[1]=vx, y[2]=y, y[3]=vy
     double vx = y[1];
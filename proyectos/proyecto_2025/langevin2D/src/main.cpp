@@ -1,15 +1,15 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include "rk_4.h"
+#include "sde_array.h"
 #include "langevin2D.h"
 
 using namespace std;
 
-const vector<double> Y0 = {0.5, 0.0, 0.5, 0.1}; // {x(0), vx(0), y(0), vy(0)}
+const LangevinSystem2D::State Y0 = {0.5, 0.0, 0.5, 0.1}; // {x(0), vx(0), y(0), vy(0)}
 const double T0 = 0.0;    // tiempo inicial
 const double TF = 500.0;  // tiempo final
-const double H = 0.01;    // paso de tiempo
+const double H = 0.05;    // paso de tiempo (BAOAB no necesita uno mas chico, ver sde_array.h)
 const double GAMMA = 0.5; // coeficiente de fricción
 
 void run_simulation(const string& name, LangevinSystem2D& system_function)
@@ -17,8 +17,10 @@ void run_simulation(const string& name, LangevinSystem2D& system_function)
     cout << "Iniciando simulación 2D con ruido " << name << "..." << endl;
     string filename = "data/langevin2d_" + name + ".dat";
 
-    rk4 solver(system_function);
-    solver.integrar_paso_fijo(Y0, T0, TF, H, filename);
+    // un incremento de ruido sqrt(H) b xi por paso; el ruido dentro del lado derecho de rk4
+    // cambiaba en cada etapa y no escalaba con el paso
+    auto solver = make_sde_array<4>(system_function);
+    solver.integrar_paso_fijo(EsquemaSDE::BAOAB, Y0, T0, TF, H, filename);
 
     cout << "-> Datos guardados en '" << filename << "'" << endl;
 }
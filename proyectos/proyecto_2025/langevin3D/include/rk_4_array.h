@@ -0,0 +1,127 @@
+#ifndef RK_4_ARRAY_H
+#define RK_4_ARRAY_H
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include "trajectory_sink.h"
+
+// RK4 para sistemas pequeños de dimensión fija (osciladores, Langevin 2D/3D...). El estado
+// es un std::array<double, N> y el lado derecho es cualquier objeto invocable F con
+//     std::array<double, N> f(double t, const std::array<double, N>& y)
+// Como N y F se conocen al compilar, f se expande en línea (sin std::function) y las
+// combinaciones de etapas se desenrollan componente a componente: un paso no reserva
+// memoria y no tiene ciclos. Los métodos de integración hacen lo mismo que los de rk4.
+//
+// Si F es una referencia (por ejemplo LangevinSystem3D&) se guarda la referencia y el
+// estado interno de f (el generador aleatorio) es el del objeto original.
+template <std::size_t N, class F>
+class rk4_array
+{
+public:
+    using State = std::array<double, N>;
+
+private:
+    F f;
+
+    // res[i] = y[i] + a * k[i] para i = 0..N-1, sin ciclo.
+    template <std::size_t... I>
+    static State axpy(const State& y, double a, const State& k, std::index_sequence<I...>) {
+        return State{(y[I] + a * k[I])...};
+    }
+
+    template <std::size_t... I>
+    static State combine(const State& y, double h, const State& k1, const State& k2, const State& k3, const State& k4,
+                         std::index_sequence<I...>) {
+        return State{(y[I] + (h / 6.0) * (k1[I] + 2.0 * k2[I] + 2.0 * k3[I] + k4[I]))...};
+    }
+
+    template <std::size_t... I>
+    static double distance_squared(const State& a, const State& b, std::index_sequence<I...>) {
+        return (0.0 + ... + ((a[I] - b[I]) * (a[I] - b[I])));
+    }
+
+public:
+    explicit rk4_array(F f) : f(std::forward<F>(f)) {}
+
+    // Un paso de RK4 desde (t, y) con paso h.
+    State paso(double t, const State& y, double h) {
+        constexpr auto idx = std::make_index_sequence<N>{};
+        const State k1 = f(t, y);
+        const State k2 = f(t + 0.5 * h, axpy(y, 0.5 * h, k1, idx));
+        const State k3 = f(t + 0.5 * h, axpy(y, 0.5 * h, k2, idx));
+        const State k4 = f(t + h, axpy(y, h, k3, idx));
+        return combine(y, h, k1, k2, k3, k4, idx);
+    }
+
+    void integrar_paso_fijo(const State& y0, double t0, double tf, double h, const std::string& archivo_salida) {
+        TextTrajectorySink data(archivo_salida);
+        integrar_paso_fijo(y0, t0, tf, h, data);
+    }
+
+    void integrar_paso_fijo(const State& y0, double t0, double tf, double h, TrajectorySink& data) {
+        data.begin(N);
+
+        State y = y0;
+        double t = t0;
+        while (t <= tf) {
+            data.write(t, y.data());
+            y = paso(t, y, h);
+            t += h;
+            if (t > tf && tf - (t-h) > 1e-12) {
+                t = tf;
+                y = paso(t-h, y, tf-(t-h));
+                data.write(t, y.data());
+            }
+        }
+        data.finish();
+    }
+
+    void integrar_adaptativo(const State& y0, double t0, double tf, double h_inicial, double tol, const std::string& archivo_salida) {
+        TextTrajectorySink data(archivo_salida);
+        integrar_adaptativo(y0, t0, tf, h_inicial, tol, data);
+    }
+
+    void integrar_adaptativo(const State& y0, double t0, double tf, double h_inicial, double tol, TrajectorySink& data) {
+        double t = t0;
+        double h = h_inicial;
+        const double h_max = 1e-2;
+        const double h_min = 1e-10;
+
+        data.begin(N);
+
+        State y = y0;
+        while (t < tf) {
+            if (t + h > tf) h = tf - t;
+
+            const State y_full = paso(t, y, h);
+            const double h_half = h / 2.0;
+            const State y_half = paso(t, y, h_half);
+            const State y_half_2 = paso(t + h_half, y_half, h_half);
+            const double error = std::sqrt(distance_squared(y_half_2, y_full, std::make_index_sequence<N>{}));
+
+            if (error <= tol) {
+                data.write(t, y.data());
+                y = y_half_2;
+                t += h;
+            }
+
+            double factor = std::pow(tol / (error + 1e-20), 0.2);
+            h *= factor;
+            if (h > h_max) h = h_max;
+            if (h < h_min) h = h_min;
+        }
+        data.finish();
+    }
+};
+
+// Deduce F a partir del argumento: make_rk4_array<6>(sistema) guarda una referencia a
+// 'sistema'; con un temporal (una lambda, por ejemplo) guarda una copia.
+template <std::size_t N, class F>
+rk4_array<N, F> make_rk4_array(F&& f) {
+    return rk4_array<N, F>(std::forward<F>(f));
+}
+
+#endif
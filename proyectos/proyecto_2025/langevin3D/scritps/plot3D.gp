@@ -1,4 +1,5 @@
 # configuracion general
+# los datos son binarios (data/*.bin); trayectoria.py los entrega como columnas de texto
 set terminal png enhanced font "Verdana,10" size 1200,900
 
 # graficos para el ruido UNIFORME
@@ -9,7 +10,7 @@ set title "Evolución Temporal 3D con Ruido Uniforme"
 set xlabel "Tiempo (t)"
 set ylabel "Posición"
 set grid
-plot 'data/langevin3d_uniforme.dat' using 1:2 with lines title 'x(t)', \
+plot '< python3 scritps/trayectoria.py data/langevin3d_uniforme.bin' using 1:2 with lines title 'x(t)', \
      '' using 1:4 with lines title 'y(t)', \
      '' using 1:6 with lines title 'z(t)'
 
@@ -21,7 +22,7 @@ set ylabel "Posición (y)"
 set zlabel "Posición (z)"
 set grid
 set view 60, 120
-splot 'data/langevin3d_uniforme.dat' using 2:4:6 with lines title 'Trayectoria (x,y,z)'
+splot '< python3 scritps/trayectoria.py data/langevin3d_uniforme.bin' using 2:4:6 with lines title 'Trayectoria (x,y,z)'
 
 # graficos para el ruido GAUSSIANO
 
@@ -31,7 +32,7 @@ set title "Evolución Temporal 3D con Ruido Gaussiano"
 set xlabel "Tiempo (t)"
 set ylabel "Posición"
 set grid
-plot 'data/langevin3d_gaussiano.dat' using 1:2 with lines title 'x(t)', \
+plot '< python3 scritps/trayectoria.py data/langevin3d_gaussiano.bin' using 1:2 with lines title 'x(t)', \
      '' using 1:4 with lines title 'y(t)', \
      '' using 1:6 with lines title 'z(t)'
 
@@ -43,7 +44,7 @@ set ylabel "Posición (y)"
 set zlabel "Posición (z)"
 set grid
 set view 60, 120
-splot 'data/langevin3d_gaussiano.dat' using 2:4:6 with lines title 'Trayectoria (x,y,z)'
+splot '< python3 scritps/trayectoria.py data/langevin3d_gaussiano.bin' using 2:4:6 with lines title 'Trayectoria (x,y,z)'
 
 set terminal pop
 print "Gráficos generados: plot/uniforme_evolution_3d.png, plot/uniforme_trajectory_3d.png, plot/gaussiano_evolution_3d.png, plot/gaussiano_trajectory_3d.png"
\ No newline at end of file
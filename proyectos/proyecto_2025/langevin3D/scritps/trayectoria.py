@@ -0,0 +1,49 @@
+# lectura de trayectorias binarias escritas por BinaryTrajectorySink (include/trajectory_sink.h)
+#
+# uso desde python (las columnas son array('d'); numpy.asarray las convierte sin copiar):
+#     from trayectoria import leer_trayectoria
+#     datos = leer_trayectoria("data/langevin3d_gaussiano.bin")
+#     t, x = datos["t"], datos["y0"]
+#
+# uso desde gnuplot (imprime las columnas como texto):
+#     plot '< python3 scritps/trayectoria.py data/langevin3d_gaussiano.bin' using 1:2
+
+import mmap
+import struct
+import sys
+from array import array
+
+
+def leer_trayectoria(archivo):
+    # el archivo se mapea en memoria; cada columna se arma con un tramo contiguo por bloque
+    with open(archivo, "rb") as f, mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as datos:
+        if datos[:8] != b"TRAJBIN\0":
+            raise ValueError(f"'{archivo}' no es una trayectoria binaria")
+        version, header_bytes, num_cols, block_rows, num_rows = struct.unpack_from("<IIQQQ", datos, 8)
+        if version != 1:
+            raise ValueError(f"versión {version} no soportada")
+
+        nombres = []
+        offset = 8 + 4 + 4 + 8 + 8 + 8
+        for _ in range(num_cols):
+            (largo,) = struct.unpack_from("<I", datos, offset)
+            nombres.append(datos[offset + 4:offset + 4 + largo].decode())
+            offset += 4 + largo
+
+        columnas = {nombre: array("d") for nombre in nombres}
+        with memoryview(datos) as vista:
+            for inicio in range(0, num_rows, block_rows):
+                filas = min(block_rows, num_rows - inicio)
+                base = header_bytes + 8 * inicio * num_cols
+                for c, nombre in enumerate(nombres):
+                    columnas[nombre].frombytes(vista[base + 8 * c * filas:base + 8 * (c + 1) * filas])
+    return columnas
+
+
+if __name__ == "__main__":
+    columnas = leer_trayectoria(sys.argv[1])
+    nombres = list(columnas.keys())
+    salida = sys.stdout
+    salida.write("# " + "\t".join(nombres) + "\n")
+    for fila in zip(*columnas.values()):
+        salida.write("\t".join("%.10e" % v for v in fila) + "\n")
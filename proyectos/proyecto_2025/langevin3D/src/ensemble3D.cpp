@@ -0,0 +1,217 @@
+#include "ensemble3D.h"
+#include "philox.h"
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // bloques consecutivos que procesa un hilo de una vez; sus sumas se juntan en orden
+    const std::size_t blocks_per_task = 4;
+}
+
+LangevinEnsemble3D::LangevinEnsemble3D(const EnsembleConfig3D& config)
+    : config_(config)
+{
+    if (config_.h <= 0.0 || config_.tf < config_.t0)
+        throw std::invalid_argument("LangevinEnsemble3D: se necesita h > 0 y tf >= t0.");
+    if (config_.sample_every == 0)
+        throw std::invalid_argument("LangevinEnsemble3D: sample_every debe ser al menos 1.");
+}
+
+// Integra las particulas [first, first + count) durante num_steps pasos y suma sus
+// estadisticas en 'sums' (que ya tiene una entrada por tiempo de muestreo).
+void LangevinEnsemble3D::simulateBlock(std::size_t first, std::size_t count, std::size_t num_steps, BlockSums& sums) const
+{
+    const double h = config_.h;
+    const double g = config_.gamma;
+    const LangevinSystem3D::State& y0 = config_.y0;
+    const std::uint32_t key0 = std::uint32_t(config_.seed);
+    const std::uint32_t key1 = std::uint32_t(config_.seed >> 32);
+    const bool gaussian = (config_.noise_type == LangevinSystem3D::GAUSSIAN);
+    // intensidad del ruido en la forma estocastica (igual que LangevinSystem3D::difusion)
+    const double b = LangevinSystem3D::noiseStd(config_.noise_type);
+    const double sqrt_h = std::sqrt(h);
+    // coeficientes del paso O de BAOAB (ver sde_array.h)
+    const double c1 = std::exp(-g * h);
+    const double c2 = (g > 0.0) ? std::sqrt(-std::expm1(-2.0 * g * h) / (2.0 * g)) : sqrt_h;
+
+    // estado del bloque por componentes; pos[c][i], vel[c][i] con c = x, y, z
+    double pos[3][block_size], vel[3][block_size];
+    // ruido de un paso, xi[c][i] de media 0 y varianza 1; la cuarta fila solo completa
+    // los pares de Box-Muller
+    double xi[4][block_size];
+    for (int c = 0; c < 3; ++c)
+    {
+        std::fill(pos[c], pos[c] + count, y0[2 * c]);
+        std::fill(vel[c], vel[c] + count, y0[2 * c + 1]);
+    }
+
+    auto accumulate = [&](std::size_t sample)
+    {
+        double s_msd = 0.0, s_msd2 = 0.0, s_vacf = 0.0, s_vacf2 = 0.0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double dx = pos[0][i] - y0[0], dy = pos[1][i] - y0[2], dz = pos[2][i] - y0[4];
+            const double msd = dx * dx + dy * dy + dz * dz;
+            const double vacf = y0[1] * vel[0][i] + y0[3] * vel[1][i] + y0[5] * vel[2][i];
+            s_msd += msd;
+            s_msd2 += msd * msd;
+            s_vacf += vacf;
+            s_vacf2 += vacf * vacf;
+        }
+        sums.msd[sample] += s_msd;
+        sums.msd2[sample] += s_msd2;
+        sums.vacf[sample] += s_vacf;
+        sums.vacf2[sample] += s_vacf2;
+    };
+
+    accumulate(0);
+    for (std::size_t n = 0; n < num_steps; ++n)
+    {
+        // 4 valores por particula: una llamada a Philox con contador (particula, paso, 0)
+        const std::uint32_t n_lo = std::uint32_t(n), n_hi = std::uint32_t(std::uint64_t(n) >> 32);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Philox4x32 r = Philox4x32::generar(std::uint32_t(first + i), n_lo, n_hi, 0u, key0, key1);
+            for (int m = 0; m < 4; ++m) xi[m][i] = uniforme_abierto(r.v[m]);
+        }
+        if (gaussian)
+        {
+            // Box-Muller con los pares (0, 1) y (2, 3), vectorizado (ver philox.h)
+            box_muller(xi[0], xi[1], count, 1.0);
+            box_muller(xi[2], xi[3], count, 1.0);
+        }
+        else
+        {
+            // uniforme en [-sqrt(3), sqrt(3)]
+            const double a = std::sqrt(3.0);
+            for (int c = 0; c < 3; ++c)
+                for (std::size_t i = 0; i < count; ++i) xi[c][i] = -a + 2.0 * a * xi[c][i];
+        }
+
+        // un paso para dx = v dt, dv = -gamma v dt + b dW (cada componente por separado)
+        for (int c = 0; c < 3; ++c)
+        {
+            double* x = pos[c];
+            double* v = vel[c];
+            const double* w = xi[c];
+            switch (config_.scheme)
+            {
+            case EsquemaSDE::EULER_MARUYAMA:
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    x[i] = x[i] + h * v[i];
+                    v[i] = v[i] - h * g * v[i] + sqrt_h * b * w[i];
+                }
+                break;
+            case EsquemaSDE::HEUN:
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const double dW = sqrt_h * b * w[i];
+                    const double v_pred = v[i] - h * g * v[i] + dW;
+                    x[i] = x[i] + 0.5 * h * (v[i] + v_pred);
+                    v[i] = v[i] - 0.5 * h * g * (v[i] + v_pred) + dW;
+                }
+                break;
+            case EsquemaSDE::BAOAB:
+                // sin fuerza los pasos B no hacen nada
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const double x_med = x[i] + 0.5 * h * v[i];
+                    v[i] = c1 * v[i] + c2 * b * w[i];
+                    x[i] = x_med + 0.5 * h * v[i];
+                }
+                break;
+            }
+        }
+
+        if ((n + 1) % config_.sample_every == 0) accumulate((n + 1) / config_.sample_every);
+    }
+}
+
+EnsembleStats3D LangevinEnsemble3D::run() const
+{
+    const std::size_t num_steps = static_cast<std::size_t>(std::llround((config_.tf - config_.t0) / config_.h));
+    const std::size_t num_samples = num_steps / config_.sample_every + 1;
+    const std::size_t num_blocks = (config_.num_particles + block_size - 1) / block_size;
+    const std::size_t num_tasks = (num_blocks + blocks_per_task - 1) / blocks_per_task;
+
+    std::vector<BlockSums> task_sums(num_tasks);
+    for (BlockSums& s : task_sums)
+    {
+        s.msd.assign(num_samples, 0.0);
+        s.msd2.assign(num_samples, 0.0);
+        s.vacf.assign(num_samples, 0.0);
+        s.vacf2.assign(num_samples, 0.0);
+    }
+
+    // cada tarea integra sus bloques en orden; las tareas se reparten entre los hilos
+    std::atomic<std::size_t> next_task{0};
+    auto worker = [&]
+    {
+        for (std::size_t task = next_task.fetch_add(1); task < num_tasks; task = next_task.fetch_add(1))
+        {
+            const std::size_t last_block = std::min(num_blocks, (task + 1) * blocks_per_task);
+            for (std::size_t b = task * blocks_per_task; b < last_block; ++b)
+            {
+                const std::size_t first = b * block_size;
+                const std::size_t count = std::min(block_size, config_.num_particles - first);
+                simulateBlock(first, count, num_steps, task_sums[task]);
+            }
+        }
+    };
+    std::size_t num_threads = config_.num_threads;
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::min(num_threads, std::max<std::size_t>(num_tasks, 1));
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < num_threads; ++t) workers.emplace_back(worker);
+    worker();
+    for (std::thread& w : workers) w.join();
+
+    // suma de las tareas siempre en el mismo orden: no depende del numero de hilos
+    EnsembleStats3D stats;
+    const double P = static_cast<double>(config_.num_particles);
+    auto mean_and_error = [P](double s1, double s2, double& mean, double& err)
+    {
+        mean = s1 / P;
+        const double var = (P > 1.0) ? std::max(0.0, (s2 / P - mean * mean) * P / (P - 1.0)) : 0.0;
+        err = std::sqrt(var / P);
+    };
+    for (std::size_t k = 0; k < num_samples; ++k)
+    {
+        double msd = 0.0, msd2 = 0.0, vacf = 0.0, vacf2 = 0.0;
+        for (const BlockSums& s : task_sums)
+        {
+            msd += s.msd[k];
+            msd2 += s.msd2[k];
+            vacf += s.vacf[k];
+            vacf2 += s.vacf2[k];
+        }
+        double m, e;
+        stats.t.push_back(config_.t0 + static_cast<double>(k * config_.sample_every) * config_.h);
+        mean_and_error(msd, msd2, m, e);
+        stats.msd.push_back(m);
+        stats.msd_err.push_back(e);
+        mean_and_error(vacf, vacf2, m, e);
+        stats.vacf.push_back(m);
+        stats.vacf_err.push_back(e);
+    }
+    return stats;
+}
+
+void LangevinEnsemble3D::save(const EnsembleStats3D& stats, const std::string& filename)
+{
+    std::ofstream data(filename);
+    if (!data.is_open())
+        throw std::runtime_error("No se pudo abrir el archivo de salida '" + filename + "'.");
+    data << "# t\tmsd\tmsd_err\tvacf\tvacf_err\n";
+    data << std::scientific << std::setprecision(10);
+    for (std::size_t k = 0; k < stats.t.size(); ++k)
+        data << stats.t[k] << "\t" << stats.msd[k] << "\t" << stats.msd_err[k] << "\t"
+             << stats.vacf[k] << "\t" << stats.vacf_err[k] << "\n";
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "ensemble3D.h"
+
+using namespace std;
+
+// estadisticas de muchas realizaciones del sistema de main.cpp (mismas condiciones
+// iniciales y mismo gamma), sin escribir las trayectorias
+const size_t NUM_PARTICLES = 20000;
+const double TF = 100.0;
+const double H = 0.05;
+const double GAMMA = 0.5;
+const size_t SAMPLE_EVERY = 2; // una muestra cada 0.1 unidades de tiempo
+
+// Para la particula libre los momentos se conocen: v es un proceso de Ornstein-Uhlenbeck,
+//     <v(0) . v(t)> = |v0|² e^{-gamma t}
+//     <|r(t) - r(0)|²> = |v0|² ((1 - e^{-gamma t}) / gamma)² + 3 var x(t)
+// y se usan para comprobar el ensamble (la diferencia debe ser del orden del error estandar).
+void compare_with_exact(const EnsembleConfig3D& config, const EnsembleStats3D& stats)
+{
+    const double g = config.gamma;
+    const double b = LangevinSystem3D::noiseStd(config.noise_type);
+    const LangevinSystem3D::State& y0 = config.y0;
+    const double v0_sq = y0[1] * y0[1] + y0[3] * y0[3] + y0[5] * y0[5];
+    double worst_msd = 0.0, worst_vacf = 0.0;
+    for (size_t k = 1; k < stats.t.size(); ++k)
+    {
+        const double t = stats.t[k] - config.t0;
+        const double drift = (1.0 - exp(-g * t)) / g;
+        const double var_x = b * b / (g * g) * (t - 2.0 * drift + (1.0 - exp(-2.0 * g * t)) / (2.0 * g));
+        const double msd = v0_sq * drift * drift + 3.0 * var_x;
+        const double vacf = v0_sq * exp(-g * t);
+        worst_msd = max(worst_msd, fabs(stats.msd[k] - msd) / stats.msd_err[k]);
+        worst_vacf = max(worst_vacf, fabs(stats.vacf[k] - vacf) / stats.vacf_err[k]);
+    }
+    cout << "   maxima diferencia con la solucion exacta: " << worst_msd << " errores estandar (MSD), "
+         << worst_vacf << " (VACF)" << endl;
+}
+
+void run_ensemble(const string& name, LangevinSystem3D::NoiseType type)
+{
+    EnsembleConfig3D config;
+    config.num_particles = NUM_PARTICLES;
+    config.noise_type = type;
+    config.gamma = GAMMA;
+    config.tf = TF;
+    config.h = H;
+    config.sample_every = SAMPLE_EVERY;
+    config.scheme = EsquemaSDE::BAOAB;
+
+    cout << "Ensamble 3D con ruido " << name << ": " << NUM_PARTICLES << " trayectorias..." << endl;
+    auto start = chrono::steady_clock::now();
+    EnsembleStats3D stats = LangevinEnsemble3D(config).run();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    string filename = "data/ensemble3d_" + name + ".dat";
+    LangevinEnsemble3D::save(stats, filename);
+    cout << "-> " << seconds << " s (" << NUM_PARTICLES * (TF / H) / seconds / 1e6
+         << " millones de pasos por segundo), datos en '" << filename << "'" << endl;
+    compare_with_exact(config, stats);
+}
+
+int main()
+{
+    run_ensemble("uniforme", LangevinSystem3D::UNIFORM);
+    run_ensemble("gaussiano", LangevinSystem3D::GAUSSIAN);
+    return 0;
+}
@@ -1,30 +1,40 @@
 #include "langevin3D.h"
 
+namespace
+{
+    std::uint64_t randomSeed()
+    {
+        std::random_device rd;
+        return (std::uint64_t(rd()) << 32) | rd();
+    }
+}
+
 LangevinSystem3D::LangevinSystem3D(NoiseType type, double gamma)
+    : LangevinSystem3D(type, gamma, randomSeed()) // inicializa con una semilla aleatoria
+{
+}
+
+LangevinSystem3D::LangevinSystem3D(NoiseType type, double gamma, std::uint64_t seed)
     : noise_type_(type),
       gamma_(gamma),
-      gen_(std::random_device{}()),
-      uniform_dist_(-0.1, 0.1),
-      gaussian_dist_(0.0, 0.05)
+      gen_(seed)
 {
 }
 
-std::vector<double> LangevinSystem3D::operator()(double t, const std::vector<double>& y)
+void LangevinSystem3D::refillNoise()
 {
-    double eta_x, eta_y, eta_z;
-
     if (noise_type_ == UNIFORM)
-    {
-        eta_x = uniform_dist_(gen_);
-        eta_y = uniform_dist_(gen_);
-        eta_z = uniform_dist_(gen_);
-    }
+        gen_.uniformes(noise_buffer_, noise_batch, -uniform_amplitude, uniform_amplitude);
     else
-    {
-        eta_x = gaussian_dist_(gen_);
-        eta_y = gaussian_dist_(gen_);
-        eta_z = gaussian_dist_(gen_);
-    }
+        gen_.normales(noise_buffer_, noise_batch, 0.0, gaussian_sigma);
+    noise_next_ = 0;
+}
+
+std::vector<double> LangevinSystem3D::operator()(double t, const std::vector<double>& y)
+{
+    const double eta_x = noise();
+    const double eta_y = noise();
+    const double eta_z = noise();
 
     // y[0]=x, y[1]=vx, y[2]=y, y[3]=vy, y[4]=z, y[5]=vz
     double vx = y[1];
@@ -1,24 +1,28 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include "rk_4.h"
+#include "sde_array.h"
 #include "langevin3D.h"
 
 using namespace std;
 
-const vector<double> Y0 = {0.5, 0.0, 0.5, 0.1, 0.5, 0.2}; // {x(0), vx(0), y(0), vy(0), z(0), vz(0)}
+const LangevinSystem3D::State Y0 = {0.5, 0.0, 0.5, 0.1, 0.5, 0.2}; // {x(0), vx(0), y(0), vy(0), z(0), vz(0)}
 const double T0 = 0.0;     // tiempo inicial
 const double TF = 500.0;   // tiempo final
-const double H = 0.01;     // paso de tiempo
+const double H = 0.05;     // paso de tiempo (BAOAB no necesita uno mas chico, ver sde_array.h)
 const double GAMMA = 0.5;  // coeficiente de friccion
 
 void run_simulation(const string& name, LangevinSystem3D& system_function)
 {
     cout << "Iniciando simulación 3D con ruido " << name << "..." << endl;
-    string filename = "data/langevin3d_" + name + ".dat";
-
-    rk4 solver(system_function);
-    solver.integrar_paso_fijo(Y0, T0, TF, H, filename);
+    string filename = "data/langevin3d_" + name + ".bin";
+
+    // salida binaria por columnas (ver trajectory_sink.h); scritps/trayectoria.py la lee
+    BinaryTrajectorySink salida(filename);
+    // un incremento de ruido sqrt(H) b xi por paso; el ruido dentro del lado derecho de rk4
+    // cambiaba en cada etapa y no escalaba con el paso
+    auto solver = make_sde_array<6>(system_function);
+    solver.integrar_paso_fijo(EsquemaSDE::BAOAB, Y0, T0, TF, H, salida);
 
     cout << "-> Datos guardados en '" << filename << "'" << endl;
 }
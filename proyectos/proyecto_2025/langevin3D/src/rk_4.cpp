@@ -8,44 +8,44 @@ rk4::rk4(const ODEFunction& f) : f(f) {}
 
 void rk4::integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, const std::string& archivo_salida)
 {
-    std::ofstream data(archivo_salida);
-    data << "# t";
-    for (size_t i = 0; i < y0.size(); ++i) data << "\ty" << i;
-    data << "\n";
-    data << std::scientific << std::setprecision(10);
+    TextTrajectorySink data(archivo_salida);
+    integrar_paso_fijo(y0, t0, tf, h, data);
+}
+
+void rk4::integrar_paso_fijo(const std::vector<double>& y0, double t0, double tf, double h, TrajectorySink& data)
+{
+    data.begin(y0.size());
 
     std::vector<double> y = y0;
     double t = t0;
     while (t <= tf)
     {
-        data << t;
-        for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
-        data << "\n";
+        data.write(t, y);
         y = rk4_step(t, y, h, f);
         t += h;
         if (t > tf && tf - (t-h) > 1e-12) {
             t = tf;
             y = rk4_step(t-h, y, tf-(t-h), f);
-            data << t;
-            for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
-            data << "\n";
+            data.write(t, y);
         }
     }
-    data.close();
+    data.finish();
 }
 
 void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, const std::string& archivo_salida)
+{
+    TextTrajectorySink data(archivo_salida);
+    integrar_adaptativo(y0, t0, tf, h_inicial, tol, data);
+}
+
+void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, TrajectorySink& data)
 {
     double t = t0;
     double h = h_inicial;
     const double h_max = 1e-2;
     const double h_min = 1e-10;
 
-    std::ofstream data(archivo_salida);
-    data << "# t";
-    for (size_t i = 0; i < y0.size(); ++i) data << "\ty" << i;
-    data << "\n";
-    data << std::scientific << std::setprecision(10);
+    data.begin(y0.size());
 
     std::vector<double> y = y0;
     while (t < tf)
@@ -64,9 +64,7 @@ void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double t
 
         if (error <= tol)
         {
-            data << t;
-            for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
-            data << "\n";
+            data.write(t, y);
             y = y_half_2;
             t += h;
         }
@@ -76,7 +74,7 @@ void rk4::integrar_adaptativo(const std::vector<double>& y0, double t0, double t
         if (h > h_max) h = h_max;
         if (h < h_min) h = h_min;
     }
-    data.close();
+    data.finish();
 }
 
 std::vector<double> rk4::rk4_step(double t, const std::vector<double>& y, double h, const ODEFunction& f)
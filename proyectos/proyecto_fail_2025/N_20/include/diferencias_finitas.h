@@ -8,6 +8,9 @@ class DiferenciasFinitas
 public:
     DiferenciasFinitas(int N, double L);
     void apply(const std::vector<double>& u, std::vector<double>& Lu) const;
+    // Igual, pero u apunta a N³ valores (por ejemplo una componente dentro del estado
+    // completo), así no hace falta copiarla a un vector aparte.
+    void apply(const double* u, std::vector<double>& Lu) const;
 
 private:
     const int N;
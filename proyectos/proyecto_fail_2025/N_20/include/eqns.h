@@ -13,6 +13,6 @@ struct ParametrosFisicos
     const double c = 1.0;
 };
 
-rk4::ODEFunction crearFuncionDelSistema(const ParametrosFisicos& config, const DiferenciasFinitas& fdm); // <-- Cambio de nombre
+rk4::ODEFunctionInPlace crearFuncionDelSistema(const ParametrosFisicos& config, const DiferenciasFinitas& fdm); // <-- Cambio de nombre
 
 #endif
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "dopri54.h"
+
+// Coeficientes de Dormand y Prince (1980).
+namespace {
+    const double c2 = 1.0 / 5.0, c3 = 3.0 / 10.0, c4 = 4.0 / 5.0, c5 = 8.0 / 9.0;
+
+    const double a21 = 1.0 / 5.0;
+    const double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+    const double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+    const double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0, a53 = 64448.0 / 6561.0, a54 = -212.0 / 729.0;
+    const double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0, a64 = 49.0 / 176.0,
+                 a65 = -5103.0 / 18656.0;
+    // Pesos de la solución de orden 5 (también son la fila 7: FSAL).
+    const double a71 = 35.0 / 384.0, a73 = 500.0 / 1113.0, a74 = 125.0 / 192.0, a75 = -2187.0 / 6784.0,
+                 a76 = 11.0 / 84.0;
+    // Diferencia entre los pesos de orden 5 y los de orden 4.
+    const double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0, e5 = -17253.0 / 339200.0,
+                 e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+    // Salida densa de orden 4 (Hairer, Nørsett y Wanner, "Solving ODE I", sec. II.6).
+    const double d1 = -12715105075.0 / 11282082432.0, d3 = 87487479700.0 / 32700410799.0,
+                 d4 = -10690763975.0 / 1880347072.0, d5 = 701980252875.0 / 199316789632.0,
+                 d6 = -1453857185.0 / 822651844.0, d7 = 69997945.0 / 29380423.0;
+
+    // Controlador PI: h_nuevo = h * seguridad * err^(-alfa) * err_anterior^beta.
+    const double seguridad = 0.9;
+    const double beta = 0.04;
+    const double alfa = 0.2 - 0.75 * beta;
+    const double factor_min = 0.2;   // el paso no se achica más que esto de una vez
+    const double factor_max = 10.0;  // ni crece más que esto
+}
+
+dopri54::dopri54(const ODEFunction& f, const Opciones& opciones)
+    : f([f](double t, const std::vector<double>& y, std::vector<double>& dydt) { dydt = f(t, y); }),
+      opciones(opciones) {}
+
+dopri54::dopri54(const ODEFunctionInPlace& f, const Opciones& opciones) : f(f), opciones(opciones) {}
+
+double dopri54::escala(std::size_t i, double y_a, double y_b) const {
+    const double atol = opciones.atol_componentes.empty() ? opciones.atol : opciones.atol_componentes[i];
+    const double rtol = opciones.rtol_componentes.empty() ? opciones.rtol : opciones.rtol_componentes[i];
+    return atol + rtol * std::max(std::abs(y_a), std::abs(y_b));
+}
+
+// Estimación del primer paso (Hairer, Nørsett y Wanner, sec. II.4): un paso de Euler
+// que cambie y en ~1% de la escala, corregido con una estimación de la segunda derivada.
+// Usa k1 = f(t0, y0), ya calculado, y una evaluación más.
+double dopri54::h_inicial_estimado(double t0, double tf) {
+    const std::size_t n = y.size();
+    const double direccion = (tf >= t0) ? 1.0 : -1.0;
+    double norma_f = 0.0, norma_y = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double sk = escala(i, y[i], y[i]);
+        norma_f += (k1[i] / sk) * (k1[i] / sk);
+        norma_y += (y[i] / sk) * (y[i] / sk);
+    }
+    double h = (norma_f <= 1e-10 || norma_y <= 1e-10) ? 1e-6 : std::sqrt(norma_y / norma_f) * 0.01;
+    h = std::min(h, opciones.h_max);
+
+    for (std::size_t i = 0; i < n; ++i) y_temp[i] = y[i] + direccion * h * k1[i];
+    f(t0 + direccion * h, y_temp, k2);
+    ++n_evaluaciones;
+    double segunda = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double sk = escala(i, y[i], y[i]);
+        segunda += ((k2[i] - k1[i]) / sk) * ((k2[i] - k1[i]) / sk);
+    }
+    segunda = std::sqrt(segunda) / h;
+
+    const double mayor = std::max(segunda, std::sqrt(norma_f));
+    const double h1 = (mayor <= 1e-15) ? std::max(1e-6, h * 1e-3) : std::pow(0.01 / mayor, 0.2);
+    return direccion * std::min({100.0 * h, h1, opciones.h_max});
+}
+
+// Calcula las etapas k2..k7 desde (t, y) con k1 = f(t, y) ya disponible, deja la
+// solución de orden 5 en y_nuevo y retorna el error normalizado.
+double dopri54::intentar_paso(double t, double h) {
+    const std::size_t n = y.size();
+
+    for (std::size_t i = 0; i < n; ++i) y_temp[i] = y[i] + h * a21 * k1[i];
+    f(t + c2 * h, y_temp, k2);
+
+    for (std::size_t i = 0; i < n; ++i) y_temp[i] = y[i] + h * (a31 * k1[i] + a32 * k2[i]);
+    f(t + c3 * h, y_temp, k3);
+
+    for (std::size_t i = 0; i < n; ++i) y_temp[i] = y[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
+    f(t + c4 * h, y_temp, k4);
+
+    for (std::size_t i = 0; i < n; ++i)
+        y_temp[i] = y[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]);
+    f(t + c5 * h, y_temp, k5);
+
+    for (std::size_t i = 0; i < n; ++i)
+        y_temp[i] = y[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]);
+    f(t + h, y_temp, k6);
+
+    for (std::size_t i = 0; i < n; ++i)
+        y_nuevo[i] = y[i] + h * (a71 * k1[i] + a73 * k3[i] + a74 * k4[i] + a75 * k5[i] + a76 * k6[i]);
+    f(t + h, y_nuevo, k7);
+    n_evaluaciones += 6;
+
+    double suma = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        error_local[i] = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+        const double r = error_local[i] / escala(i, y[i], y_nuevo[i]);
+        suma += r * r;
+    }
+    return std::sqrt(suma / static_cast<double>(n));
+}
+
+// Coeficientes del polinomio de interpolación del paso [t, t + h] (antes de pasar a
+// y_nuevo y de mover k7 a k1).
+void dopri54::preparar_salida_densa(double h) {
+    const std::size_t n = y.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const double dy = y_nuevo[i] - y[i];
+        const double bspl = h * k1[i] - dy;
+        rcont1[i] = y[i];
+        rcont2[i] = dy;
+        rcont3[i] = bspl;
+        rcont4[i] = dy - h * k7[i] - bspl;
+        rcont5[i] = h * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] + d5 * k5[i] + d6 * k6[i] + d7 * k7[i]);
+    }
+}
+
+void dopri54::interpolar(double t, std::vector<double>& res) const {
+    if (t_act == t_ant) {
+        res = y;
+        return;
+    }
+    const double s = (t - t_ant) / (t_act - t_ant);
+    const double s1 = 1.0 - s;
+    for (std::size_t i = 0; i < y.size(); ++i)
+        res[i] = rcont1[i] + s * (rcont2[i] + s1 * (rcont3[i] + s * (rcont4[i] + s1 * rcont5[i])));
+}
+
+std::vector<double> dopri54::integrar(const std::vector<double>& y0, double t0, double tf, const Observador& observador) {
+    const std::size_t n = y0.size();
+    if ((!opciones.atol_componentes.empty() && opciones.atol_componentes.size() != n) ||
+        (!opciones.rtol_componentes.empty() && opciones.rtol_componentes.size() != n)) {
+        throw std::invalid_argument("Error: Las tolerancias por componente no tienen el tamaño del sistema.");
+    }
+    for (std::vector<double>* v : {&k1, &k2, &k3, &k4, &k5, &k6, &k7, &y_temp, &y_nuevo, &error_local,
+                                   &rcont1, &rcont2, &rcont3, &rcont4, &rcont5}) {
+        v->resize(n);
+    }
+    y = y0;
+    t_ant = t_act = t0;
+    n_evaluaciones = n_aceptados = n_rechazados = 0;
+
+    f(t0, y, k1);
+    ++n_evaluaciones;
+    if (observador) observador(*this);
+    if (t0 == tf || n == 0) return y;
+
+    const double direccion = (tf > t0) ? 1.0 : -1.0;
+    double h = (opciones.h_inicial > 0.0) ? direccion * std::min(opciones.h_inicial, opciones.h_max)
+                                          : h_inicial_estimado(t0, tf);
+    double t = t0;
+    double error_anterior = 1e-4;
+    bool rechazado = false;
+
+    for (std::size_t paso = 0; direccion * (tf - t) > 0.0; ++paso) {
+        if (paso >= opciones.max_pasos) {
+            throw std::runtime_error("Error: dopri54 superó el número máximo de pasos.");
+        }
+        if (std::abs(h) <= 16.0 * std::numeric_limits<double>::epsilon() * std::abs(t)) {
+            throw std::runtime_error("Error: dopri54 necesita un paso demasiado pequeño (¿sistema rígido o singular?).");
+        }
+        // Si el paso sobrepasa tf (o queda muy cerca) se termina justo en tf.
+        if (direccion * (t + 1.01 * h - tf) > 0.0) h = tf - t;
+
+        const double err = intentar_paso(t, h);
+        const double err_alfa = std::pow(std::max(err, 1e-10), alfa);
+
+        if (err <= 1.0) {
+            double factor = seguridad / err_alfa * std::pow(error_anterior, beta);
+            factor = std::clamp(factor, factor_min, factor_max);
+            if (rechazado) factor = std::min(factor, 1.0); // no crecer justo después de un rechazo
+            error_anterior = std::max(err, 1e-4);
+
+            preparar_salida_densa(h);
+            t_ant = t;
+            t = (direccion * (tf - (t + h)) <= 0.0) ? tf : t + h;
+            t_act = t;
+            std::swap(y, y_nuevo);
+            std::swap(k1, k7); // FSAL: f(t + h, y_nuevo) es la primera etapa del paso siguiente
+            ++n_aceptados;
+            rechazado = false;
+            if (observador) observador(*this);
+
+            h *= factor;
+            if (std::abs(h) > opciones.h_max) h = direccion * opciones.h_max;
+        } else {
+            h *= std::max(factor_min, seguridad / err_alfa);
+            ++n_rechazados;
+            rechazado = true;
+        }
+    }
+    return y;
+}
+
+std::vector<double> dopri54::integrar(const std::vector<double>& y0, double t0, double tf, TrajectorySink& salida) {
+    salida.begin(y0.size());
+    std::vector<double> res = integrar(y0, t0, tf, [&salida](const dopri54& s) { salida.write(s.t_actual(), s.estado()); });
+    salida.finish();
+    return res;
+}
+
+std::vector<double> dopri54::integrar(const std::vector<double>& y0, double t0, double tf, const std::string& archivo_salida) {
+    TextTrajectorySink data(archivo_salida);
+    return integrar(y0, t0, tf, data);
+}
+
+std::vector<double> dopri54::integrar(const std::vector<double>& y0, double t0, double tf,
+                                      const std::vector<double>& tiempos, TrajectorySink& salida) {
+    const double direccion = (tf >= t0) ? 1.0 : -1.0;
+    std::vector<double> y_t(y0.size());
+    std::size_t siguiente = 0;
+
+    salida.begin(y0.size());
+    std::vector<double> res = integrar(y0, t0, tf, [&](const dopri54& s) {
+        while (siguiente < tiempos.size() && direccion * (s.t_actual() - tiempos[siguiente]) >= 0.0) {
+            if (direccion * (tiempos[siguiente] - t0) >= 0.0) {
+                s.interpolar(tiempos[siguiente], y_t);
+                salida.write(tiempos[siguiente], y_t);
+            }
+            ++siguiente;
+        }
+    });
+    salida.finish();
+    return res;
+}
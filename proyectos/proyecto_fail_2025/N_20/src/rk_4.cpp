@@ -2,27 +2,40 @@
 #include <fstream>
 #include <cmath>
 #include <iomanip>
+#include <utility>
 #include "rk_4.h"
 
-rk4::rk4(const ODEFunction& f) : f(f) {}
+rk4::rk4(const ODEFunction& f)
+    : f([f](double t, const std::vector<double>& y, std::vector<double>& dydt) { dydt = f(t, y); }) {}
 
-std::vector<double> rk4::rk4_step(double t, const std::vector<double>& y, double h, const ODEFunction& f)
+rk4::rk4(const ODEFunctionInPlace& f) : f(f) {}
+
+void rk4::Workspace::resize(std::size_t n)
+{
+    k1.resize(n);
+    k2.resize(n);
+    k3.resize(n);
+    k4.resize(n);
+    temp.resize(n);
+}
+
+void rk4::rk4_step(double t, const std::vector<double>& y, double h, const ODEFunctionInPlace& f,
+                   Workspace& ws, std::vector<double>& y_out)
 {
-    std::vector<double> k1 = f(t, y);
-    std::vector<double> k2(y.size()), k3(y.size()), k4(y.size()), temp(y.size()), result(y.size());
+    const size_t n = y.size();
+    f(t, y, ws.k1);
 
-    for (size_t i = 0; i < y.size(); ++i) temp[i] = y[i] + 0.5 * h * k1[i];
-    k2 = f(t + 0.5 * h, temp);
+    for (size_t i = 0; i < n; ++i) ws.temp[i] = y[i] + 0.5 * h * ws.k1[i];
+    f(t + 0.5 * h, ws.temp, ws.k2);
 
-    for (size_t i = 0; i < y.size(); ++i) temp[i] = y[i] + 0.5 * h * k2[i];
-    k3 = f(t + 0.5 * h, temp);
+    for (size_t i = 0; i < n; ++i) ws.temp[i] = y[i] + 0.5 * h * ws.k2[i];
+    f(t + 0.5 * h, ws.temp, ws.k3);
 
-    for (size_t i = 0; i < y.size(); ++i) temp[i] = y[i] + h * k3[i];
-    k4 = f(t + h, temp);
+    for (size_t i = 0; i < n; ++i) ws.temp[i] = y[i] + h * ws.k3[i];
+    f(t + h, ws.temp, ws.k4);
 
-    for (size_t i = 0; i < y.size(); ++i)
-        result[i] = y[i] + (h / 6.0) * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
-    return result;
+    for (size_t i = 0; i < n; ++i)
+        y_out[i] = y[i] + (h / 6.0) * (ws.k1[i] + 2.0 * ws.k2[i] + 2.0 * ws.k3[i] + ws.k4[i]);
 }
 
 // Versión original (corregida) que escribe en archivo
@@ -37,6 +50,9 @@ std::vector<double> rk4::integrar_adaptativo(const std::vector<double>& y0, doub
     double t = t0;
     double h = h_inicial;
     std::vector<double> y = y0;
+    // Se reservan una sola vez: los pasos solo escriben en estos vectores.
+    std::vector<double> y_full(y.size()), y_half_1(y.size()), y_half_2(y.size());
+    ws.resize(y.size());
 
     const double h_max = 1e-2;
     const double h_min = 1e-10;
@@ -49,10 +65,10 @@ std::vector<double> rk4::integrar_adaptativo(const std::vector<double>& y0, doub
     {
         if (t + h > tf) h = tf - t;
 
-        std::vector<double> y_full = rk4_step(t, y, h, f);
+        rk4_step(t, y, h, f, ws, y_full);
         double h_half = h / 2.0;
-        std::vector<double> y_half_1 = rk4_step(t, y, h_half, f);
-        std::vector<double> y_half_2 = rk4_step(t + h_half, y_half_1, h_half, f);
+        rk4_step(t, y, h_half, f, ws, y_half_1);
+        rk4_step(t + h_half, y_half_1, h_half, f, ws, y_half_2);
         
         double error_norm_sq = 0.0;
         for (size_t i = 0; i < y_full.size(); ++i) {
@@ -64,7 +80,7 @@ std::vector<double> rk4::integrar_adaptativo(const std::vector<double>& y0, doub
         if (error <= tol)
         {
             t += h;
-            y = y_half_2;
+            std::swap(y, y_half_2);
 
             data << t;
             for (size_t i = 0; i < y.size(); ++i) data << "\t" << y[i];
@@ -87,6 +103,8 @@ std::vector<double> rk4::integrar_adaptativo(const std::vector<double>& y0, doub
     double t = t0;
     double h = h_inicial;
     std::vector<double> y = y0;
+    std::vector<double> y_full(y.size()), y_half_1(y.size()), y_half_2(y.size());
+    ws.resize(y.size());
 
     const double h_max = 1e-2;
     const double h_min = 1e-10;
@@ -95,10 +113,10 @@ std::vector<double> rk4::integrar_adaptativo(const std::vector<double>& y0, doub
     {
         if (t + h > tf) h = tf - t;
 
-        std::vector<double> y_full = rk4_step(t, y, h, f);
+        rk4_step(t, y, h, f, ws, y_full);
         double h_half = h / 2.0;
-        std::vector<double> y_half_1 = rk4_step(t, y, h_half, f);
-        std::vector<double> y_half_2 = rk4_step(t + h_half, y_half_1, h_half, f);
+        rk4_step(t, y, h_half, f, ws, y_half_1);
+        rk4_step(t + h_half, y_half_1, h_half, f, ws, y_half_2);
         
         double error_norm_sq = 0.0;
         for (size_t i = 0; i < y_full.size(); ++i) {
@@ -109,7 +127,7 @@ std::vector<double> rk4::integrar_adaptativo(const std::vector<double>& y0, doub
 
         if (error <= tol) {
             t += h;
-            y = y_half_2;
+            std::swap(y, y_half_2);
         }
 
         double factor = 0.9 * std::pow(tol / (error + 1e-20), 0.2);
@@ -0,0 +1,265 @@
+#ifndef DATA_LOADER_H
+#define DATA_LOADER_H
+
+#include <vector>       // Para std::vector
+#include <string>       // Para std::string
+#include <fstream>      // Para std::ifstream (cuando no hay mmap)
+#include <sstream>      // Para std::ostringstream (mensajes de error)
+#include <charconv>     // Para std::from_chars
+#include <cstring>      // Para std::memchr
+#include <stdexcept>    // Para std::runtime_error
+#include <thread>       // Para std::thread
+#include <atomic>       // Para std::atomic
+#include <algorithm>    // Para std::min, std::max, std::count
+#include <cstddef>      // Para std::size_t
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>      // Para open
+#include <sys/mman.h>   // Para mmap, munmap, madvise
+#include <sys/stat.h>   // Para fstat
+#include <unistd.h>     // Para close
+#define DATA_LOADER_USE_MMAP 1
+#endif
+
+/* --- Lectura rápida de archivos de datos numéricos --- */
+// Los archivos de datos (una fila por línea, números separados por espacios o
+// tabuladores, en cualquier cantidad) se leen sin iostreams: el archivo se mapea en
+// memoria, se divide en trozos que terminan en un salto de línea y cada trozo se
+// convierte con std::from_chars en un hilo distinto. Los valores se escriben
+// directamente en un arreglo contiguo por columna.
+//
+// Los errores (archivo inexistente, campo no numérico, filas de distinto largo) se
+// informan con std::runtime_error indicando la línea.
+
+/* --- MappedFile Class Declaration --- */
+// Archivo de solo lectura mapeado en memoria (o leído completo si no hay mmap).
+class MappedFile
+{
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef DATA_LOADER_USE_MMAP
+    void* map_ = nullptr;
+#else
+    std::string buffer_;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef DATA_LOADER_USE_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Error: No se pudo abrir el archivo '" + path + "'.");
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Error: No se pudo leer el tamaño del archivo '" + path + "'.");
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            map_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map_ == MAP_FAILED) {
+                map_ = nullptr;
+                ::close(fd);
+                throw std::runtime_error("Error: No se pudo mapear en memoria el archivo '" + path + "'.");
+            }
+            ::madvise(map_, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(map_);
+        }
+        ::close(fd); // El mapeo sigue siendo válido después de cerrar el descriptor.
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Error: No se pudo abrir el archivo '" + path + "'.");
+        }
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        buffer_ = ss.str();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef DATA_LOADER_USE_MMAP
+        if (map_ != nullptr) ::munmap(map_, size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+};
+
+inline bool is_data_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Convierte los números de la línea que empieza en p y los agrega a 'out'. Deja p al
+// comienzo de la línea siguiente. Retorna false si algún campo no es un número.
+inline bool parse_numeric_line(const char*& p, const char* end, std::vector<double>& out) {
+    while (p < end && *p != '\n') {
+        if (is_data_separator(*p)) {
+            ++p;
+            continue;
+        }
+        const char* start = (*p == '+') ? p + 1 : p; // from_chars no acepta el signo '+'.
+        double value;
+        const std::from_chars_result res = std::from_chars(start, end, value);
+        if (res.ec != std::errc() || (res.ptr < end && !is_data_separator(*res.ptr) && *res.ptr != '\n')) {
+            return false;
+        }
+        out.push_back(value);
+        p = res.ptr;
+    }
+    if (p < end) ++p; // Salta el '\n'.
+    return true;
+}
+
+// Número de la línea (desde 1) que contiene la posición 'offset' del archivo.
+inline std::size_t data_line_number(const char* data, std::size_t offset) {
+    return static_cast<std::size_t>(std::count(data, data + offset, '\n')) + 1;
+}
+
+// Error para la línea inválida en 'offset' (expected_cols = 0: solo se sabe que hay un
+// valor no numérico).
+inline std::runtime_error data_line_error(const std::string& path, const char* data, std::size_t offset,
+                                          std::size_t expected_cols = 0) {
+    std::ostringstream msg;
+    msg << "Error: La línea " << data_line_number(data, offset) << " del archivo '" << path << "'";
+    if (expected_cols == 0) {
+        msg << " contiene un valor no numérico.";
+    } else {
+        msg << " no tiene " << expected_cols << " números válidos.";
+    }
+    return std::runtime_error(msg.str());
+}
+
+/* --- DataColumns Struct Declaration --- */
+// Datos de un archivo por columnas: columns[j][i] es el valor de la columna j en la fila i.
+struct DataColumns
+{
+    std::vector<std::vector<double>> columns;
+
+    std::size_t rows() const { return columns.empty() ? 0 : columns[0].size(); }
+    std::size_t cols() const { return columns.size(); }
+};
+
+// Tamaño mínimo (en bytes) de cada trozo que procesa un hilo.
+inline constexpr std::size_t data_loader_min_chunk_bytes = std::size_t(1) << 20;
+
+// Lee un archivo de datos numéricos. Las líneas vacías se ignoran y todas las demás deben
+// tener el mismo número de columnas que la primera. num_threads = 0 usa todos los núcleos.
+inline DataColumns load_data_columns(const std::string& path, std::size_t num_threads = 0) {
+    const MappedFile file(path);
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    // El número de columnas lo fija la primera línea no vacía.
+    std::vector<double> first;
+    const char* p = data;
+    while (p < end && first.empty()) {
+        const char* line = p;
+        if (!parse_numeric_line(p, end, first)) {
+            throw data_line_error(path, data, static_cast<std::size_t>(line - data));
+        }
+    }
+    const std::size_t ncols = first.size();
+    DataColumns res;
+    res.columns.resize(ncols);
+    if (ncols == 0) return res;
+
+    // Trozos que terminan justo después de un '\n'.
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t target = std::max(data_loader_min_chunk_bytes, file.size() / (num_threads * 8) + 1);
+    std::vector<const char*> bounds{data};
+    while (bounds.back() < end) {
+        const char* next = bounds.back() + std::min(target, static_cast<std::size_t>(end - bounds.back()));
+        if (next < end) {
+            const void* nl = std::memchr(next, '\n', static_cast<std::size_t>(end - next));
+            next = (nl == nullptr) ? end : static_cast<const char*>(nl) + 1;
+        }
+        bounds.push_back(next);
+    }
+    const std::size_t n_chunks = bounds.size() - 1;
+
+    // Ejecuta task(c) para cada trozo c repartiendo los trozos entre los hilos.
+    const std::size_t n_workers = std::min(num_threads, n_chunks);
+    auto run_chunks = [&](auto&& task) {
+        std::atomic<std::size_t> next_chunk{0};
+        auto worker = [&] {
+            for (std::size_t c = next_chunk.fetch_add(1); c < n_chunks; c = next_chunk.fetch_add(1)) task(c);
+        };
+        std::vector<std::thread> workers;
+        for (std::size_t t = 1; t < n_workers; ++t) workers.emplace_back(worker);
+        worker();
+        for (std::thread& w : workers) w.join();
+    };
+
+    // 1) Filas (líneas con algún carácter que no sea separador) de cada trozo.
+    std::vector<std::size_t> row_offset(n_chunks + 1, 0);
+    run_chunks([&](std::size_t c) {
+        std::size_t count = 0;
+        for (const char* q = bounds[c]; q < bounds[c + 1];) {
+            while (q < bounds[c + 1] && is_data_separator(*q)) ++q;
+            if (q < bounds[c + 1] && *q != '\n') ++count;
+            const void* nl = std::memchr(q, '\n', static_cast<std::size_t>(bounds[c + 1] - q));
+            q = (nl == nullptr) ? bounds[c + 1] : static_cast<const char*>(nl) + 1;
+        }
+        row_offset[c + 1] = count;
+    });
+    for (std::size_t c = 0; c < n_chunks; ++c) row_offset[c + 1] += row_offset[c];
+    for (std::vector<double>& column : res.columns) column.resize(row_offset[n_chunks]);
+
+    // 2) Cada trozo se convierte directamente en su rango de filas de las columnas.
+    // 'errors' guarda la posición de la primera línea inválida de cada trozo (o el tamaño
+    // del archivo si no hay errores).
+    std::vector<std::size_t> errors(n_chunks, file.size());
+    run_chunks([&](std::size_t c) {
+        std::vector<double> row;
+        row.reserve(ncols);
+        std::size_t r = row_offset[c];
+        for (const char* q = bounds[c]; q < bounds[c + 1];) {
+            const char* line = q;
+            row.clear();
+            if (!parse_numeric_line(q, bounds[c + 1], row) || (!row.empty() && row.size() != ncols)) {
+                errors[c] = static_cast<std::size_t>(line - data);
+                return;
+            }
+            if (row.empty()) continue;
+            for (std::size_t j = 0; j < ncols; ++j) res.columns[j][r] = row[j];
+            ++r;
+        }
+    });
+
+    const std::size_t first_error = *std::min_element(errors.begin(), errors.end());
+    if (first_error < file.size()) {
+        throw data_line_error(path, data, first_error, ncols);
+    }
+    return res;
+}
+
+// Recorre el archivo fila por fila (en serie y sin guardar los datos) y llama a
+// row_callback(const std::vector<double>& fila) para cada línea no vacía. Si el callback
+// retorna false se detiene y la función retorna false.
+template <class F>
+bool for_each_data_row(const std::string& path, F&& row_callback) {
+    const MappedFile file(path);
+    const char* data = file.data();
+    const char* end = data + file.size();
+    std::vector<double> row;
+    for (const char* p = data; p < end;) {
+        const char* line = p;
+        row.clear();
+        if (!parse_numeric_line(p, end, row)) {
+            throw data_line_error(path, data, static_cast<std::size_t>(line - data));
+        }
+        if (!row.empty() && !row_callback(row)) return false;
+    }
+    return true;
+}
+
+#endif
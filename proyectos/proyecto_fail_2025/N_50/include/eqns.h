@@ -14,6 +14,6 @@ struct PhysicsParameters {
 };
 
 // Se actualiza el tipo del parámetro en la firma de la función
-rk4::ODEFunction create_maxwell_system_function(const PhysicsParameters& params, const DiferenciasFinitas& fdm);
+rk4::ODEFunctionInPlace create_maxwell_system_function(const PhysicsParameters& params, const DiferenciasFinitas& fdm);
 
 #endif
\ No newline at end of file
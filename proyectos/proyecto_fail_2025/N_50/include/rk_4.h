@@ -10,13 +10,27 @@ class rk4
 {
 public:
     using ODEFunction = std::function<std::vector<double>(double, const std::vector<double>&)>;
+    // Lado derecho "en el lugar": escribe f(t, y) en dydt, que ya tiene el tamaño de y.
+    // Con esta forma un paso no reserva memoria.
+    using ODEFunctionInPlace = std::function<void(double, const std::vector<double>&, std::vector<double>&)>;
+
+    // Etapas de un paso de RK4. Se reservan una vez (resize) y se reutilizan en cada paso.
+    struct Workspace
+    {
+        std::vector<double> k1, k2, k3, k4, temp;
+        void resize(std::size_t n);
+    };
 
 private:
-    ODEFunction f;
-    static std::vector<double> rk4_step(double t, const std::vector<double>& y, double h, const ODEFunction& f);
+    ODEFunctionInPlace f;
+    Workspace ws;
+    // y_out puede ser el mismo vector que y.
+    static void rk4_step(double t, const std::vector<double>& y, double h, const ODEFunctionInPlace& f,
+                         Workspace& ws, std::vector<double>& y_out);
 
 public:
     rk4(const ODEFunction& f);
+    rk4(const ODEFunctionInPlace& f);
     
     // Versión que guarda en archivo
     std::vector<double> integrar_adaptativo(const std::vector<double>& y0, double t0, double tf, double h_inicial, double tol, const std::string& archivo_salida);
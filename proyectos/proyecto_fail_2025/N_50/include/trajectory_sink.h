@@ -0,0 +1,238 @@
+#ifndef TRAJECTORY_SINK_H
+#define TRAJECTORY_SINK_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include "data_loader.h" // MappedFile
+
+// Destino de los estados (t, y) que producen los integradores. Los integradores solo
+// llaman a begin/write/finish, así que el formato de salida se elige al construir el
+// destino: texto (compatible con gnuplot) o binario por columnas (mucho más compacto y
+// sin conversión a texto).
+class TrajectorySink
+{
+public:
+    virtual ~TrajectorySink() = default;
+
+    // Se llama una vez, antes del primer estado, con la dimensión del sistema.
+    virtual void begin(std::size_t dimension) = 0;
+    // Registra un estado: y apunta a 'dimension' valores.
+    virtual void write(double t, const double* y) = 0;
+    // Vacía los búferes y cierra el archivo.
+    virtual void finish() = 0;
+
+    void write(double t, const std::vector<double>& y) { write(t, y.data()); }
+};
+
+// Texto: "# t  y0  y1 ..." y una línea por estado en notación científica (el formato
+// original de rk4).
+class TextTrajectorySink : public TrajectorySink
+{
+private:
+    std::ofstream data_;
+    std::size_t dimension_ = 0;
+
+public:
+    explicit TextTrajectorySink(const std::string& archivo) : data_(archivo)
+    {
+        if (!data_.is_open())
+            throw std::runtime_error("No se pudo abrir el archivo de salida '" + archivo + "'.");
+    }
+
+    void begin(std::size_t dimension) override
+    {
+        dimension_ = dimension;
+        data_ << "# t";
+        for (std::size_t i = 0; i < dimension; ++i) data_ << "\ty" << i;
+        data_ << "\n";
+        data_ << std::scientific << std::setprecision(10);
+    }
+
+    void write(double t, const double* y) override
+    {
+        data_ << t;
+        for (std::size_t i = 0; i < dimension_; ++i) data_ << "\t" << y[i];
+        data_ << "\n";
+    }
+
+    void finish() override { data_.close(); }
+};
+
+/* Formato binario por columnas (little-endian)
+
+   Cabecera (tamaño múltiplo de 8 bytes):
+     char     magic[8]      "TRAJBIN\0"
+     uint32   version       1
+     uint32   header_bytes  tamaño total de la cabecera
+     uint64   num_cols      1 + dimensión (la columna 0 es t)
+     uint64   block_rows    filas por bloque
+     uint64   num_rows      filas escritas (se actualiza al vaciar cada bloque)
+     por columna: uint32 largo + nombre ("t", "y0", "y1", ...), con relleno final hasta
+     múltiplo de 8
+
+   Datos: bloques de block_rows filas (el último puede ser menor). Dentro de un bloque
+   cada columna ocupa un tramo contiguo de doubles: t[0..r), y0[0..r), y1[0..r), ...
+   Así una columna completa se lee con pocos tramos grandes y cada bloque se escribe
+   con una sola llamada a write. */
+
+inline constexpr char trajectory_magic[8] = {'T', 'R', 'A', 'J', 'B', 'I', 'N', '\0'};
+inline constexpr std::uint32_t trajectory_version = 1;
+inline constexpr std::size_t trajectory_default_block_rows = 4096;
+inline constexpr std::size_t trajectory_num_rows_offset = 8 + 4 + 4 + 8 + 8; // posición de num_rows
+
+class BinaryTrajectorySink : public TrajectorySink
+{
+private:
+    std::ofstream data_;
+    std::size_t cols_ = 0;
+    std::size_t block_rows_;
+    std::size_t buffered_ = 0;       // filas en el bloque actual
+    std::uint64_t num_rows_ = 0;     // filas ya escritas al archivo
+    std::vector<double> block_;      // bloque actual, por columnas: block_[c*block_rows_ + r]
+
+    template <class U>
+    void put(const U& value) { data_.write(reinterpret_cast<const char*>(&value), sizeof(U)); }
+
+    void flush_block()
+    {
+        if (buffered_ == 0) return;
+        for (std::size_t c = 0; c < cols_; ++c)
+            data_.write(reinterpret_cast<const char*>(block_.data() + c * block_rows_), buffered_ * sizeof(double));
+        num_rows_ += buffered_;
+        buffered_ = 0;
+
+        // actualiza num_rows en la cabecera (el archivo es legible aunque el programa se corte)
+        const std::streampos end = data_.tellp();
+        data_.seekp(trajectory_num_rows_offset);
+        put(num_rows_);
+        data_.seekp(end);
+    }
+
+public:
+    explicit BinaryTrajectorySink(const std::string& archivo, std::size_t block_rows = trajectory_default_block_rows)
+        : data_(archivo, std::ios::binary), block_rows_(block_rows > 0 ? block_rows : 1)
+    {
+        if (!data_.is_open())
+            throw std::runtime_error("No se pudo abrir el archivo de salida '" + archivo + "'.");
+    }
+
+    ~BinaryTrajectorySink() override
+    {
+        if (data_.is_open()) finish();
+    }
+
+    void begin(std::size_t dimension) override
+    {
+        cols_ = dimension + 1;
+        block_.assign(cols_ * block_rows_, 0.0);
+
+        std::vector<std::string> names{"t"};
+        for (std::size_t i = 0; i < dimension; ++i) names.push_back("y" + std::to_string(i));
+        std::size_t header_bytes = trajectory_num_rows_offset + 8;
+        for (const std::string& name : names) header_bytes += 4 + name.size();
+        header_bytes = (header_bytes + 7) / 8 * 8;
+
+        data_.write(trajectory_magic, 8);
+        put(trajectory_version);
+        put(static_cast<std::uint32_t>(header_bytes));
+        put(static_cast<std::uint64_t>(cols_));
+        put(static_cast<std::uint64_t>(block_rows_));
+        put(num_rows_);
+        std::size_t written = trajectory_num_rows_offset + 8;
+        for (const std::string& name : names)
+        {
+            put(static_cast<std::uint32_t>(name.size()));
+            data_.write(name.data(), name.size());
+            written += 4 + name.size();
+        }
+        for (; written < header_bytes; ++written) data_.put('\0');
+    }
+
+    void write(double t, const double* y) override
+    {
+        block_[buffered_] = t;
+        for (std::size_t c = 1; c < cols_; ++c) block_[c * block_rows_ + buffered_] = y[c - 1];
+        if (++buffered_ == block_rows_) flush_block();
+    }
+
+    void finish() override
+    {
+        flush_block();
+        data_.close();
+    }
+};
+
+// Lectura de un archivo binario de trayectoria mapeado en memoria (sin conversión de texto).
+class TrajectoryReader
+{
+private:
+    MappedFile file_;
+    std::size_t cols_ = 0, block_rows_ = 0, rows_ = 0, header_bytes_ = 0;
+    std::vector<std::string> names_;
+
+    template <class U>
+    U get(std::size_t offset) const
+    {
+        U value;
+        std::memcpy(&value, file_.data() + offset, sizeof(U));
+        return value;
+    }
+
+public:
+    explicit TrajectoryReader(const std::string& archivo) : file_(archivo)
+    {
+        if (file_.size() < trajectory_num_rows_offset + 8 || std::memcmp(file_.data(), trajectory_magic, 8) != 0)
+            throw std::runtime_error("El archivo '" + archivo + "' no es una trayectoria binaria.");
+        if (get<std::uint32_t>(8) != trajectory_version)
+            throw std::runtime_error("Versión de trayectoria binaria no soportada en '" + archivo + "'.");
+        header_bytes_ = get<std::uint32_t>(12);
+        cols_ = get<std::uint64_t>(16);
+        block_rows_ = get<std::uint64_t>(24);
+        rows_ = get<std::uint64_t>(trajectory_num_rows_offset);
+
+        std::size_t offset = trajectory_num_rows_offset + 8;
+        for (std::size_t c = 0; c < cols_; ++c)
+        {
+            const std::uint32_t len = get<std::uint32_t>(offset);
+            names_.emplace_back(file_.data() + offset + 4, len);
+            offset += 4 + len;
+        }
+        if (header_bytes_ + rows_ * cols_ * sizeof(double) > file_.size())
+            throw std::runtime_error("El archivo de trayectoria '" + archivo + "' está incompleto.");
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    const std::vector<std::string>& names() const { return names_; }
+
+    // Valor de la columna c en la fila r (columna 0 = t).
+    double operator()(std::size_t r, std::size_t c) const
+    {
+        const std::size_t block = r / block_rows_;
+        const std::size_t rows_in_block = std::min(block_rows_, rows_ - block * block_rows_);
+        const std::size_t offset = header_bytes_ + (block * block_rows_ * cols_ + c * rows_in_block + r % block_rows_) * sizeof(double);
+        return get<double>(offset);
+    }
+
+    // Copia la columna c completa (un tramo contiguo por bloque).
+    std::vector<double> column(std::size_t c) const
+    {
+        if (c >= cols_) throw std::out_of_range("Columna fuera de rango en TrajectoryReader.");
+        std::vector<double> res(rows_);
+        for (std::size_t start = 0; start < rows_; start += block_rows_)
+        {
+            const std::size_t rows_in_block = std::min(block_rows_, rows_ - start);
+            const char* src = file_.data() + header_bytes_ + (start * cols_ + c * rows_in_block) * sizeof(double);
+            std::memcpy(res.data() + start, src, rows_in_block * sizeof(double));
+        }
+        return res;
+    }
+};
+
+#endif
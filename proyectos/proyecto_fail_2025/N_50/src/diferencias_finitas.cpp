@@ -13,6 +13,10 @@ int DiferenciasFinitas::index(int i, int j, int k) const {
 }
 
 void DiferenciasFinitas::apply(const std::vector<double>& u, std::vector<double>& Lu) const {
+    apply(u.data(), Lu);
+}
+
+void DiferenciasFinitas::apply(const double* u, std::vector<double>& Lu) const {
     Lu.assign(N * N * N, 0.0);
     #pragma omp parallel for
     for (int i = 0; i < N; ++i) {
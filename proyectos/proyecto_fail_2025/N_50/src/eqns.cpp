@@ -2,26 +2,33 @@
 #include <cmath>
 #include <vector>
 
+// Arreglos auxiliares del lado derecho. Se dimensionan en la primera evaluación y luego
+// se reutilizan, así evaluar el sistema no reserva memoria.
+struct SystemBuffers {
+    std::vector<double> lap_Ex, lap_Ey, lap_Ez, lap_Bx, lap_By, lap_Bz;
+    std::vector<double> dJdt, curlJ, Jz;
+};
+
 // Declaramos las funciones de ayuda como 'static' para limitar su alcance a este archivo.
 static int index(int i, int j, int k, int N);
 static void get_coords(int idx, const PhysicsParameters& p, double& x, double& y, double& z);
-static void calculate_sources(double t, const PhysicsParameters& p, std::vector<double>& dJdt, std::vector<double>& curlJ);
+static void calculate_sources(double t, const PhysicsParameters& p, std::vector<double>& dJdt, std::vector<double>& curlJ, std::vector<double>& Jz);
 static void interpolate_fields(const std::vector<double>& y, const PhysicsParameters& p, double x, double y_pos, double z, double& Ex, double& Ey, double& Ez, double& Bx, double& By, double& Bz);
 
 
 // --- Implementación de la función pública que crea la función del sistema ---
 
-rk4::ODEFunction create_maxwell_system_function(const PhysicsParameters& params, const DiferenciasFinitas& fdm) {
+rk4::ODEFunctionInPlace create_maxwell_system_function(const PhysicsParameters& params, const DiferenciasFinitas& fdm) {
     
-    // Devolvemos una lambda que captura los parámetros y el operador por referencia.
-    return [=](double t, const std::vector<double>& y) -> std::vector<double> {
+    // Devolvemos una lambda que captura los parámetros, el operador y sus propios búferes.
+    return [=, buf = SystemBuffers()](double t, const std::vector<double>& y, std::vector<double>& dydt) mutable {
         const int N = params.N;
         const int N3 = N * N * N;
         const size_t num_field_vars = 12 * N3;
         const double c2 = params.c * params.c;
         const double four_pi = 4.0 * M_PI;
         
-        std::vector<double> dydt(y.size(), 0.0);
+        dydt.resize(y.size()); // Todas las componentes se escriben abajo.
 
         // --- Parte 1: Evolución de los Campos E y B ---
         const double* Ex = &y[0*N3]; const double* Ey = &y[1*N3]; const double* Ez = &y[2*N3];
@@ -29,18 +36,19 @@ rk4::ODEFunction create_maxwell_system_function(const PhysicsParameters& params,
         const double* VEx = &y[6*N3]; const double* VEy = &y[7*N3]; const double* VEz = &y[8*N3];
         const double* VBx = &y[9*N3]; const double* VBy = &y[10*N3]; const double* VBz = &y[11*N3];
 
-        std::vector<double> lap_Ex(N3), lap_Ey(N3), lap_Ez(N3);
-        std::vector<double> lap_Bx(N3), lap_By(N3), lap_Bz(N3);
+        auto& lap_Ex = buf.lap_Ex; auto& lap_Ey = buf.lap_Ey; auto& lap_Ez = buf.lap_Ez;
+        auto& lap_Bx = buf.lap_Bx; auto& lap_By = buf.lap_By; auto& lap_Bz = buf.lap_Bz;
 
-        fdm.apply(std::vector<double>(Ex, Ex + N3), lap_Ex);
-        fdm.apply(std::vector<double>(Ey, Ey + N3), lap_Ey);
-        fdm.apply(std::vector<double>(Ez, Ez + N3), lap_Ez);
-        fdm.apply(std::vector<double>(Bx, Bx + N3), lap_Bx);
-        fdm.apply(std::vector<double>(By, By + N3), lap_By);
-        fdm.apply(std::vector<double>(Bz, Bz + N3), lap_Bz);
+        fdm.apply(Ex, lap_Ex);
+        fdm.apply(Ey, lap_Ey);
+        fdm.apply(Ez, lap_Ez);
+        fdm.apply(Bx, lap_Bx);
+        fdm.apply(By, lap_By);
+        fdm.apply(Bz, lap_Bz);
 
-        std::vector<double> dJdt, curlJ;
-        calculate_sources(t, params, dJdt, curlJ);
+        auto& dJdt = buf.dJdt;
+        auto& curlJ = buf.curlJ;
+        calculate_sources(t, params, dJdt, curlJ, buf.Jz);
 
         for (int i = 0; i < N3; ++i) {
             dydt[i + 0*N3] = VEx[i]; dydt[i + 1*N3] = VEy[i]; dydt[i + 2*N3] = VEz[i];
@@ -76,8 +84,6 @@ rk4::ODEFunction create_maxwell_system_function(const PhysicsParameters& params,
             dydt[num_field_vars + 4] = Fy / params.m;
             dydt[num_field_vars + 5] = Fz / params.m;
         }
-        
-        return dydt;
     };
 }
 
@@ -98,7 +104,7 @@ static void get_coords(int idx, const PhysicsParameters& p, double& x, double& y
     z = k * p.h;
 }
 
-static void calculate_sources(double t, const PhysicsParameters& p, std::vector<double>& dJdt, std::vector<double>& curlJ) {
+static void calculate_sources(double t, const PhysicsParameters& p, std::vector<double>& dJdt, std::vector<double>& curlJ, std::vector<double>& Jz) {
     const int N = p.N;
     const int N3 = N * N * N;
     dJdt.assign(3 * N3, 0.0);
@@ -107,7 +113,7 @@ static void calculate_sources(double t, const PhysicsParameters& p, std::vector<
     double* dJdt_z = &dJdt[2 * N3];
     double* curlJ_x = &curlJ[0 * N3];
     double* curlJ_y = &curlJ[1 * N3];
-    std::vector<double> Jz(N3, 0.0);
+    Jz.assign(N3, 0.0);
 
     for (int i = 0; i < N3; ++i) {
         double x, y, z;